@@ -0,0 +1,407 @@
+#include "BlendGraphBenchmark.h"
+#include "Synthetic.h"
+#include "Animation/Generator.h"
+#include "Animation/PosePool.h"
+#include "Physics/ModelSpaceSystem.h"
+#include "Serialization/BlendGraphImport.h"
+#include "Settings/Settings.h"
+#include "Util/Memory.h"
+#include "Util/Profiler.h"
+
+namespace Benchmark
+{
+	namespace detail
+	{
+		constexpr uint64_t NO_INPUT = 0;
+		constexpr size_t MAX_CHAIN_STAGES = Animation::Procedural::PGraph::MAX_DEPTH - 2;
+
+		class GraphWriter
+		{
+		public:
+			uint64_t Add(const std::string_view a_type, std::initializer_list<std::pair<std::string_view, uint64_t>> a_inputs = {}, const std::string_view a_values = {})
+			{
+				const uint64_t id = ++lastId;
+				nodes += std::format("{}\t\t{{ \"id\": {}, \"type\": \"{}\"", id == 1 ? "" : ",\n", id, a_type);
+				if (a_inputs.size() > 0) {
+					nodes += ", \"inputs\": {";
+					bool first = true;
+					for (auto& [name, target] : a_inputs) {
+						nodes += std::format("{} \"{}\": [{}]", first ? "" : ",", name, target);
+						first = false;
+					}
+					nodes += " }";
+				}
+				if (!a_values.empty()) {
+					nodes += std::format(", \"values\": {{ {} }}", a_values);
+				}
+				nodes += " }";
+				return id;
+			}
+
+			std::string Finish() const
+			{
+				return std::format("{{\n\t\"version\": 1,\n\t\"nodes\": [\n{}\n\t]\n}}\n", nodes);
+			}
+
+			size_t GetNumNodes() const
+			{
+				return lastId;
+			}
+
+		private:
+			// IDs start at 1 so NO_INPUT never refers to a real node.
+			uint64_t lastId = 0;
+			std::string nodes;
+		};
+
+		std::string BoneValues(size_t a_boneIdx)
+		{
+			return std::format("\"bone\": \"{}\", \"is_ms\": false", GetBoneName(a_boneIdx));
+		}
+
+		// Any bone except the root, which some modifiers reject.
+		size_t GetModifierBone(size_t a_idx, size_t a_numBones)
+		{
+			return 1 + a_idx % (a_numBones - 1);
+		}
+
+		void WriteDeepChain(GraphWriter& a_writer, size_t a_stages, size_t a_numBones)
+		{
+			const uint64_t base = a_writer.Add("base_pose");
+			const uint64_t weight = a_writer.Add("var", {}, "\"name\": \"weight\", \"defVal\": 0.5");
+			const uint64_t rot = a_writer.Add("fixed_vec", {}, "\"x\": 0.0, \"y\": 0.0, \"z\": 0.0499792, \"w\": 0.9987503");
+			const uint64_t pos = a_writer.Add("fixed_vec", {}, "\"x\": 0.0, \"y\": 0.1, \"z\": 0.02, \"w\": 0.0");
+
+			uint64_t prev = base;
+			for (size_t i = 0; i < a_stages; i++) {
+				const size_t bone = GetModifierBone(i, a_numBones);
+				switch (i % 3) {
+				case 0:
+					prev = a_writer.Add("set_bone_rot", { { "pose", prev }, { "rot", rot } }, BoneValues(bone));
+					break;
+				case 1:
+					prev = a_writer.Add("set_bone_pos", { { "pose", prev }, { "position", pos } }, BoneValues(bone));
+					break;
+				default:
+					prev = a_writer.Add("blend_1d", { { "1", prev }, { "2", base }, { "val", weight } });
+					break;
+				}
+			}
+			a_writer.Add("actor", { { "input", prev } });
+		}
+
+		void WriteWideBlend(GraphWriter& a_writer, size_t a_leaves, size_t a_numBones)
+		{
+			const uint64_t base = a_writer.Add("base_pose");
+			const uint64_t weight = a_writer.Add("var", {}, "\"name\": \"weight\", \"defVal\": 0.5");
+			const uint64_t rot = a_writer.Add("fixed_vec", {}, "\"x\": 0.0, \"y\": 0.0, \"z\": 0.0499792, \"w\": 0.9987503");
+
+			std::vector<uint64_t> level;
+			for (size_t i = 0; i < std::max(a_leaves, 2ui64); i++) {
+				level.push_back(a_writer.Add("set_bone_rot", { { "pose", base }, { "rot", rot } }, BoneValues(GetModifierBone(i, a_numBones))));
+			}
+
+			while (level.size() > 1) {
+				std::vector<uint64_t> next;
+				for (size_t i = 0; i < level.size(); i += 2) {
+					if (i + 1 < level.size()) {
+						next.push_back(a_writer.Add("blend_1d", { { "1", level[i] }, { "2", level[i + 1] }, { "val", weight } }));
+					} else {
+						next.push_back(level[i]);
+					}
+				}
+				level = std::move(next);
+			}
+			a_writer.Add("actor", { { "input", level[0] } });
+		}
+
+		bool WriteIKSpring(GraphWriter& a_writer, size_t a_stages, size_t a_numBones)
+		{
+			// Each stage works on a chain start bone and the 3 bones below it.
+			const size_t numChains = a_numBones >= 5 ? (a_numBones - 5) / CHAIN_LENGTH + 1 : 0;
+			if (numChains == 0)
+				return false;
+
+			const uint64_t base = a_writer.Add("base_pose");
+			const uint64_t target = a_writer.Add("fixed_vec", {}, "\"x\": 0.3, \"y\": 0.5, \"z\": 0.2, \"w\": 0.0");
+			const uint64_t offset = a_writer.Add("fixed_vec", {}, "\"x\": 0.0, \"y\": 0.0, \"z\": 0.0, \"w\": 0.0");
+			const uint64_t stiff = a_writer.Add("fixed_val", {}, "\"val\": 80.0");
+			const uint64_t damp = a_writer.Add("fixed_val", {}, "\"val\": 4.0");
+			const uint64_t mass = a_writer.Add("fixed_val", {}, "\"val\": 1.0");
+			const uint64_t props = a_writer.Add("spring_props", { { "stiff", stiff }, { "damp", damp }, { "mass", mass }, { "gravity", NO_INPUT } },
+				"\"up_x\": 0.0, \"up_y\": 0.0, \"up_z\": 1.0");
+
+			uint64_t prev = base;
+			for (size_t i = 0; i < a_stages; i++) {
+				const size_t chainStart = 1 + CHAIN_LENGTH * ((i / 3) % numChains);
+				switch (i % 3) {
+				case 0:
+					prev = a_writer.Add("ik_2b_adj", { { "pose", prev }, { "target", target } },
+						std::format("\"start_node\": \"{}\", \"mid_node\": \"{}\", \"end_node\": \"{}\", \"mid_x\": 0.0, \"mid_y\": 0.0, \"mid_z\": 1.0",
+							GetBoneName(chainStart), GetBoneName(chainStart + 1), GetBoneName(chainStart + 2)));
+					break;
+				case 1:
+					prev = a_writer.Add("ik_1b", { { "pose", prev }, { "target", target }, { "offset", offset } },
+						std::format("\"bone\": \"{}\", \"up_x\": 0.0, \"up_y\": 0.0, \"up_z\": 1.0, \"forward_x\": 0.0, \"forward_y\": 1.0, \"forward_z\": 0.0",
+							GetBoneName(chainStart + 2)));
+					break;
+				default:
+					prev = a_writer.Add("spring_bone", { { "pose", prev }, { "linearProps", props }, { "angularProps", props }, { "linearConstr", NO_INPUT }, { "angularConstr", NO_INPUT } },
+						std::format("\"bone\": \"{}\"", GetBoneName(chainStart + 3)));
+					break;
+				}
+			}
+			a_writer.Add("actor", { { "input", prev } });
+			return true;
+		}
+
+		// Mirrors the generator state set up by Graph for a procedural generator.
+		struct GraphInstance
+		{
+			Animation::PoseCache poseCache;
+			Animation::PoseCache::Handle restPose;
+			std::vector<ozz::math::Float4x4> modelSpaceCache;
+			ozz::math::Float4x4 rootTransform = ozz::math::Float4x4::identity();
+			ozz::math::Float4x4 prevRootTransform = ozz::math::Float4x4::identity();
+			std::unique_ptr<Physics::ModelSpaceSystem> physSystem;
+			std::unique_ptr<Animation::ProceduralGenerator> generator;
+
+			size_t GetSizeBytes() const
+			{
+				return sizeof(GraphInstance) + generator->GetSizeBytes() + poseCache.heap_bytes() + Util::Memory::GetHeapBytes(modelSpaceCache) +
+				       (physSystem ? sizeof(Physics::ModelSpaceSystem) : 0);
+			}
+		};
+
+		std::unique_ptr<GraphInstance> CreateInstance(const std::shared_ptr<Animation::Procedural::PGraph>& a_graph, const Animation::OzzSkeleton* a_skeleton)
+		{
+			auto result = std::make_unique<GraphInstance>();
+			result->poseCache.set_pose_size(a_skeleton->data->num_soa_joints());
+			result->restPose = result->poseCache.acquire_handle();
+			const auto restPoses = a_skeleton->data->joint_rest_poses();
+			std::copy(restPoses.begin(), restPoses.end(), result->restPose.get().begin());
+			result->modelSpaceCache.resize(a_skeleton->data->num_joints(), ozz::math::Float4x4::identity());
+
+			result->generator = std::make_unique<Animation::ProceduralGenerator>(a_graph);
+			if (result->generator->RequiresPhysicsSystem()) {
+				result->physSystem = std::make_unique<Physics::ModelSpaceSystem>();
+			}
+			result->generator->SetContext({
+				.modelSpaceCache = result->modelSpaceCache,
+				.prevRootTransform = &result->prevRootTransform,
+				.rootTransform = &result->rootTransform,
+				.restPose = &result->restPose,
+				.skeleton = a_skeleton,
+				.physSystem = result->physSystem.get()
+			});
+			return result;
+		}
+
+		void RunGraph(BlendGraphResult& a_result, const BlendGraphConfig& a_config, const std::shared_ptr<const Animation::OzzSkeleton>& a_skeleton)
+		{
+			size_t numNodes = 0;
+			const std::string json = GenerateBlendGraphJson(a_result.topology, a_result.size, a_skeleton.get(), numNodes);
+			if (json.empty()) {
+				a_result.error = "Skeleton is too small for this topology.";
+				return;
+			}
+			a_result.fileNodes = numNodes;
+
+			{
+				std::ofstream file(a_result.path, std::ios::trunc);
+				file << json;
+				if (!file.good()) {
+					a_result.error = "Failed to write graph file.";
+					return;
+				}
+			}
+
+			const uint64_t loadStart = Util::Profiler::ReadTimestamp();
+			std::shared_ptr<Animation::Procedural::PGraph> graph = Serialization::BlendGraphImport::LoadGraph(a_result.path, a_config.graphDir, a_skeleton->name);
+			a_result.loadMs = Util::Profiler::TicksToMs(Util::Profiler::ReadTimestamp() - loadStart);
+			if (!graph) {
+				a_result.error = "Failed to load graph.";
+				return;
+			}
+
+			a_result.graphNodes = graph->nodes.size();
+
+			std::vector<std::unique_ptr<GraphInstance>> instances;
+			for (size_t i = 0; i < a_config.numInstances; i++) {
+				instances.push_back(CreateInstance(graph, a_skeleton.get()));
+			}
+
+			std::vector<Animation::Procedural::PGraph::BatchEntry> batch;
+			for (auto& inst : instances) {
+				batch.push_back({ .graphInst = &inst->generator->pGraphInstance, .poseCache = &inst->poseCache });
+			}
+
+			uint64_t evaluateTicks = 0;
+			const size_t totalFrames = a_config.warmupFrames + a_config.numFrames;
+			for (size_t f = 0; f < totalFrames; f++) {
+				// Keeps blend weights away from 0 and 1, so no blend can be skipped.
+				const float weight = 0.5f + 0.4f * std::sin(static_cast<float>(f) * 0.05f);
+				for (auto& inst : instances) {
+					inst->generator->SetVariable("weight", weight);
+				}
+
+				const uint64_t start = Util::Profiler::ReadTimestamp();
+				for (auto& inst : instances) {
+					inst->generator->AdvanceTime(a_config.deltaTime);
+					if (inst->physSystem) {
+						inst->physSystem->Update(a_config.deltaTime, inst->rootTransform, inst->prevRootTransform);
+					}
+					if (!a_config.batchEvaluation) {
+						auto output = inst->generator->Generate(inst->poseCache, nullptr);
+						DoNotOptimize(output.data());
+						inst->generator->ReleaseTransientPoses();
+					}
+				}
+				if (a_config.batchEvaluation) {
+					graph->EvaluateBatch(batch);
+					for (auto& e : batch) {
+						DoNotOptimize(e.output.data());
+					}
+					for (auto& inst : instances) {
+						inst->generator->ReleaseTransientPoses();
+					}
+				}
+				if (f >= a_config.warmupFrames) {
+					evaluateTicks += Util::Profiler::ReadTimestamp() - start;
+				}
+			}
+
+			a_result.numInstances = instances.size();
+			a_result.numFrames = a_config.numFrames;
+			a_result.evaluateMs = Util::Profiler::TicksToMs(evaluateTicks);
+			a_result.poseSlots = graph->numPoseSlots;
+			for (auto& inst : instances) {
+				a_result.bytesPerInstance = std::max(a_result.bytesPerInstance, inst->GetSizeBytes());
+			}
+		}
+	}
+
+	std::string BlendGraphResult::GetName() const
+	{
+		return std::format("{}_{}", GetTopologyName(topology), size);
+	}
+
+	double BlendGraphResult::GetNodesPerSec() const
+	{
+		const double evaluations = static_cast<double>(graphNodes) * static_cast<double>(numInstances) * static_cast<double>(numFrames);
+		return evaluateMs > 0.0 ? evaluations / (evaluateMs / 1000.0) : 0.0;
+	}
+
+	double BlendGraphResult::GetNsPerInstanceFrame() const
+	{
+		const size_t updates = numInstances * numFrames;
+		return updates > 0 ? (evaluateMs * 1'000'000.0) / static_cast<double>(updates) : 0.0;
+	}
+
+	std::string GenerateBlendGraphJson(BlendGraphTopology a_topology, size_t a_size, const Animation::OzzSkeleton* a_skeleton, size_t& a_numNodes)
+	{
+		a_numNodes = 0;
+		const size_t numBones = static_cast<size_t>(a_skeleton->data->num_joints());
+		if (numBones < 2)
+			return {};
+
+		detail::GraphWriter writer;
+		switch (a_topology) {
+		case BlendGraphTopology::kDeepChain:
+			detail::WriteDeepChain(writer, std::min(a_size, detail::MAX_CHAIN_STAGES), numBones);
+			break;
+		case BlendGraphTopology::kWideBlend:
+			detail::WriteWideBlend(writer, a_size, numBones);
+			break;
+		case BlendGraphTopology::kIKSpring:
+			if (!detail::WriteIKSpring(writer, std::min(a_size, detail::MAX_CHAIN_STAGES), numBones))
+				return {};
+			break;
+		default:
+			return {};
+		}
+
+		a_numNodes = writer.GetNumNodes();
+		return writer.Finish();
+	}
+
+	std::vector<BlendGraphResult> RunBlendGraphBenchmark(const BlendGraphConfig& a_config)
+	{
+		Util::Memory::InstallOzzAllocator();
+		std::vector<BlendGraphResult> results;
+		std::error_code ec;
+		std::filesystem::create_directories(a_config.graphDir, ec);
+		if (ec) {
+			logger::warn("Failed to create blend graph directory '{}'.", a_config.graphDir.string());
+			return results;
+		}
+
+		auto skeleton = CreateSkeleton(a_config.numBones);
+		if (!skeleton) {
+			logger::warn("Blend graph benchmark: failed to build a skeleton with {} bones.", a_config.numBones);
+			return results;
+		}
+
+		// BlendGraphImport looks skeletons up by name, so the synthetic skeleton is registered for the duration of the run.
+		Settings::RegisterSkeleton(std::const_pointer_cast<Animation::OzzSkeleton>(skeleton));
+
+		for (const auto topology : a_config.topologies) {
+			for (const size_t size : a_config.sizes) {
+				auto& r = results.emplace_back();
+				r.topology = topology;
+				r.size = size;
+				r.path = a_config.graphDir / (r.GetName() + Serialization::BlendGraphImport::FILE_EXTENSION);
+				detail::RunGraph(r, a_config, skeleton);
+
+				// Each run's instances are gone by now, so their chunks are freed here instead of carrying over into the
+				// next run's numbers.
+				Animation::PosePool::ReleaseScratch();
+				Animation::PosePool::GetSingleton()->Trim();
+			}
+		}
+
+		Settings::UnregisterSkeleton(skeleton->name);
+		return results;
+	}
+
+	void LogBlendGraphResults(const std::vector<BlendGraphResult>& a_results)
+	{
+		for (const auto& r : a_results) {
+			if (!r.error.empty()) {
+				logger::warn("Blend graph benchmark: {} failed: {}", r.GetName(), r.error);
+				continue;
+			}
+
+			logger::info("Blend graph benchmark: {} ({} nodes in file, {} evaluated, {} instances, {} frames)", r.GetName(), r.fileNodes, r.graphNodes, r.numInstances, r.numFrames);
+			logger::info("    load {:.3f} ms, {:.0f} ns/instance/frame, {:.0f} nodes/sec", r.loadMs, r.GetNsPerInstanceFrame(), r.GetNodesPerSec());
+			logger::info("    {} pose slots, {} bytes/instance", r.poseSlots, r.bytesPerInstance);
+		}
+	}
+
+	std::vector<MicroBenchmarkResult> BlendGraphResultsToMicroBenchmarkResults(const std::vector<BlendGraphResult>& a_results)
+	{
+		std::vector<MicroBenchmarkResult> result;
+		for (const auto& r : a_results) {
+			result.push_back({ .name = std::format("BM_BlendGraph/{}", r.GetName()),
+				.iterations = r.numInstances * r.numFrames,
+				.realTimeNs = r.GetNsPerInstanceFrame(),
+				.itemsPerSecond = r.GetNodesPerSec(),
+				.error = r.error });
+		}
+		return result;
+	}
+
+	std::string_view GetTopologyName(BlendGraphTopology a_topology)
+	{
+		switch (a_topology) {
+		case BlendGraphTopology::kDeepChain:
+			return "deep_chain";
+		case BlendGraphTopology::kWideBlend:
+			return "wide_blend";
+		case BlendGraphTopology::kIKSpring:
+			return "ik_spring";
+		default:
+			return "unknown";
+		}
+	}
+}
\ No newline at end of file
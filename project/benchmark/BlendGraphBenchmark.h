@@ -0,0 +1,64 @@
+#pragma once
+#include "MicroBenchmark.h"
+#include "Animation/Ozz.h"
+
+namespace Benchmark
+{
+	enum class BlendGraphTopology : uint8_t
+	{
+		// A single long chain of pose modifiers, occasionally blended back against the base pose.
+		kDeepChain,
+		// A balanced tree of 1D blends over many leaf poses.
+		kWideBlend,
+		// A chain of two-bone IK, one-bone IK and spring bone nodes.
+		kIKSpring,
+
+		kTotal
+	};
+
+	// Writes synthetic .bt files, loads them through Serialization::BlendGraphImport and evaluates a number of instances
+	// of each graph against a synthetic skeleton.
+	struct BlendGraphConfig
+	{
+		std::filesystem::path graphDir = std::filesystem::temp_directory_path() / "NAF-BlendGraphs";
+		std::vector<BlendGraphTopology> topologies = { BlendGraphTopology::kDeepChain, BlendGraphTopology::kWideBlend, BlendGraphTopology::kIKSpring };
+		// Number of pose stages for chains, or number of leaf poses for blend trees.
+		std::vector<size_t> sizes = { 8, 32, 90 };
+		size_t numBones = 80;
+		size_t numInstances = 16;
+		size_t numFrames = 300;
+		size_t warmupFrames = 30;
+		float deltaTime = 1.0f / 60.0f;
+		// Evaluates all instances of a graph together through PGraph::EvaluateBatch instead of one at a time.
+		bool batchEvaluation = false;
+	};
+
+	struct BlendGraphResult
+	{
+		std::filesystem::path path;
+		BlendGraphTopology topology = BlendGraphTopology::kDeepChain;
+		size_t size = 0;
+		size_t fileNodes = 0;
+		// Nodes evaluated per frame.
+		size_t graphNodes = 0;
+		size_t numInstances = 0;
+		size_t numFrames = 0;
+		double loadMs = 0.0;
+		double evaluateMs = 0.0;
+		// Peak number of poses the graph holds at once during an evaluation, from PGraph::numPoseSlots.
+		size_t poseSlots = 0;
+		size_t bytesPerInstance = 0;
+		std::string error;
+
+		std::string GetName() const;
+		double GetNodesPerSec() const;
+		double GetNsPerInstanceFrame() const;
+	};
+
+	// Returns the graph as JSON in the format read by BlendGraphImport::LoadGraph. a_numNodes receives the number of nodes written.
+	std::string GenerateBlendGraphJson(BlendGraphTopology a_topology, size_t a_size, const Animation::OzzSkeleton* a_skeleton, size_t& a_numNodes);
+	std::vector<BlendGraphResult> RunBlendGraphBenchmark(const BlendGraphConfig& a_config = {});
+	void LogBlendGraphResults(const std::vector<BlendGraphResult>& a_results);
+	std::vector<MicroBenchmarkResult> BlendGraphResultsToMicroBenchmarkResults(const std::vector<BlendGraphResult>& a_results);
+	std::string_view GetTopologyName(BlendGraphTopology a_topology);
+}
\ No newline at end of file
@@ -0,0 +1,259 @@
+#include "GLTFImportBenchmark.h"
+#include "Synthetic.h"
+#include "Serialization/GLTFExport.h"
+#include "Serialization/GLTFImport.h"
+#include "Util/Memory.h"
+#include "Util/Profiler.h"
+#include "zstr.hpp"
+
+namespace Benchmark
+{
+	namespace detail
+	{
+		bool WriteCorpusFile(const GLTFCorpusEntry& a_entry, const std::vector<std::byte>& a_data)
+		{
+			try {
+				if (a_entry.gzip) {
+					zstr::ofstream file(a_entry.path.generic_string(), std::ios::binary);
+					file.write(reinterpret_cast<const char*>(a_data.data()), a_data.size());
+					return !file.bad();
+				} else {
+					std::ofstream file(a_entry.path, std::ios::binary | std::ios::trunc);
+					file.write(reinterpret_cast<const char*>(a_data.data()), a_data.size());
+					return file.good();
+				}
+			} catch (const std::exception&) {
+				return false;
+			}
+		}
+
+		size_t CountKeyframes(const Animation::RawOzzAnimation& a_raw)
+		{
+			size_t result = 0;
+			if (a_raw.data) {
+				for (auto& t : a_raw.data->tracks) {
+					result += t.translations.size() + t.rotations.size() + t.scales.size();
+				}
+			}
+			if (a_raw.faceData) {
+				for (auto& t : a_raw.faceData->tracks) {
+					result += t.keyframes.size();
+				}
+			}
+			return result;
+		}
+
+		std::map<size_t, std::shared_ptr<const Animation::OzzSkeleton>> skeletons;
+
+		const Animation::OzzSkeleton* GetSkeleton(size_t a_numJoints)
+		{
+			auto& result = skeletons[a_numJoints];
+			if (!result) {
+				result = CreateSkeleton(a_numJoints);
+			}
+			return result.get();
+		}
+	}
+
+	std::string GLTFCorpusEntry::GetName() const
+	{
+		return std::format("j{}_d{:g}_k{}_c{:g}_m{}{}", numJoints, duration, numKeys, channelDensity, numMorphs, gzip ? "_gz" : "");
+	}
+
+	double GLTFImportResult::GetMBPerSec(GLTFImportPhase a_phase) const
+	{
+		const double ms = phaseMs[static_cast<size_t>(a_phase)];
+		return ms > 0.0 ? (static_cast<double>(decodedBytes) / 1'000'000.0) / (ms / 1000.0) : 0.0;
+	}
+
+	double GLTFImportResult::GetKeyframesPerSec(GLTFImportPhase a_phase) const
+	{
+		const double ms = phaseMs[static_cast<size_t>(a_phase)];
+		return ms > 0.0 ? static_cast<double>(keyframes) / (ms / 1000.0) : 0.0;
+	}
+
+	double GLTFImportResult::GetCyclesPerKeyframe(GLTFImportPhase a_phase) const
+	{
+		return keyframes > 0 ? static_cast<double>(phaseCycles[static_cast<size_t>(a_phase)]) / static_cast<double>(keyframes) : 0.0;
+	}
+
+	std::vector<GLTFCorpusEntry> GenerateGLTFCorpus(const GLTFImportConfig& a_config)
+	{
+		std::vector<GLTFCorpusEntry> result;
+		std::error_code ec;
+		std::filesystem::create_directories(a_config.corpusDir, ec);
+		if (ec) {
+			logger::warn("Failed to create glTF corpus directory '{}'.", a_config.corpusDir.string());
+			return result;
+		}
+
+		for (const size_t numJoints : a_config.jointCounts) {
+			const auto skeleton = detail::GetSkeleton(numJoints);
+			if (!skeleton)
+				continue;
+
+			for (const float duration : a_config.durations) {
+				for (const float density : a_config.channelDensities) {
+					for (const size_t numMorphs : a_config.morphCounts) {
+						GLTFCorpusEntry entry{
+							.numJoints = numJoints,
+							.duration = duration,
+							.numKeys = static_cast<size_t>(std::max(duration * a_config.keysPerSecond, 2.0f)),
+							.channelDensity = density,
+							.numMorphs = std::min(numMorphs, static_cast<size_t>(FACE_MORPHS_SIZE))
+						};
+
+						auto raw = CreateRawAnimation(skeleton, entry.duration, entry.numKeys, entry.channelDensity, entry.numMorphs);
+						const auto data = Serialization::GLTFExport::CreateOptimizedAsset(raw.get(), skeleton->data.get());
+						if (data.empty()) {
+							logger::warn("Failed to export glTF corpus file {}.", entry.GetName());
+							continue;
+						}
+
+						for (const bool gzip : { false, true }) {
+							if (gzip && !a_config.writeGzip)
+								continue;
+
+							entry.gzip = gzip;
+							entry.path = a_config.corpusDir / (entry.GetName() + ".glb");
+							if (detail::WriteCorpusFile(entry, data)) {
+								result.push_back(entry);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		return result;
+	}
+
+	std::vector<GLTFImportResult> RunGLTFImportBenchmark(const GLTFImportConfig& a_config)
+	{
+		Util::Memory::InstallOzzAllocator();
+		using Phase = GLTFImportPhase;
+		std::vector<GLTFImportResult> results;
+		const auto corpus = GenerateGLTFCorpus(a_config);
+
+		for (const auto& entry : corpus) {
+			auto& r = results.emplace_back();
+			r.entry = entry;
+			std::error_code ec;
+			r.fileBytes = static_cast<size_t>(std::filesystem::file_size(entry.path, ec));
+
+			const auto skeleton = detail::GetSkeleton(entry.numJoints);
+			std::vector<uint8_t> buffer;
+			const size_t iterations = std::max(a_config.iterations, 1ui64);
+
+			for (size_t i = 0; i < iterations; i++) {
+				std::array<uint64_t, GLTFImportResult::NUM_PHASES> stamps{};
+				stamps[0] = Util::Profiler::ReadTimestamp();
+
+				size_t bufferSize = 0;
+				if (!Serialization::GLTFImport::ReadGLTFBuffer(entry.path, buffer, bufferSize)) {
+					r.error = "Failed to read file.";
+					break;
+				}
+				stamps[1] = Util::Profiler::ReadTimestamp();
+
+				auto assetData = Serialization::GLTFImport::ParseGLTF(buffer, bufferSize, entry.path.parent_path());
+				if (!assetData || assetData->asset.animations.empty()) {
+					r.error = "Failed to parse file.";
+					break;
+				}
+				stamps[2] = Util::Profiler::ReadTimestamp();
+
+				auto raw = Serialization::GLTFImport::CreateRawAnimation(assetData.get(), &assetData->asset.animations[0], skeleton);
+				if (!raw || !raw->data) {
+					r.error = "Failed to decode animation.";
+					break;
+				}
+				stamps[3] = Util::Profiler::ReadTimestamp();
+
+				// Mirrors GLTFImport::CreateRuntimeAnimation.
+				ozz::animation::offline::AnimationBuilder builder;
+				auto anim = builder(*raw->data);
+				if (raw->faceData) {
+					ozz::animation::offline::TrackBuilder trackBuilder;
+					for (auto& t : raw->faceData->tracks) {
+						auto track = trackBuilder(t);
+						DoNotOptimize(track);
+					}
+				}
+				stamps[4] = Util::Profiler::ReadTimestamp();
+				if (!anim) {
+					r.error = "Failed to build runtime animation.";
+					break;
+				}
+
+				r.decodedBytes = bufferSize;
+				r.keyframes = detail::CountKeyframes(*raw);
+				for (size_t p = 0; p < static_cast<size_t>(Phase::kTotal); p++) {
+					r.phaseCycles[p] += stamps[p + 1] - stamps[p];
+				}
+				r.phaseCycles[static_cast<size_t>(Phase::kTotal)] += stamps[4] - stamps[0];
+				r.iterations++;
+			}
+
+			if (r.iterations > 0) {
+				for (size_t p = 0; p < GLTFImportResult::NUM_PHASES; p++) {
+					r.phaseCycles[p] /= r.iterations;
+					r.phaseMs[p] = Util::Profiler::TicksToMs(r.phaseCycles[p]);
+				}
+			}
+		}
+
+		detail::skeletons.clear();
+		return results;
+	}
+
+	void LogGLTFImportResults(const std::vector<GLTFImportResult>& a_results)
+	{
+		for (const auto& r : a_results) {
+			if (!r.error.empty()) {
+				logger::warn("glTF import benchmark: {} failed: {}", r.entry.GetName(), r.error);
+				continue;
+			}
+
+			logger::info("glTF import benchmark: {} ({} bytes on disk, {} bytes decoded, {} keyframes)", r.entry.GetName(), r.fileBytes, r.decodedBytes, r.keyframes);
+			for (size_t i = 0; i < GLTFImportResult::NUM_PHASES; i++) {
+				const auto phase = static_cast<GLTFImportPhase>(i);
+				logger::info("    {:<12} {:>10.3f} ms {:>10.1f} MB/s {:>14.0f} keyframes/sec {:>10.1f} cycles/keyframe",
+					GetPhaseName(phase), r.phaseMs[i], r.GetMBPerSec(phase), r.GetKeyframesPerSec(phase), r.GetCyclesPerKeyframe(phase));
+			}
+		}
+	}
+
+	std::vector<MicroBenchmarkResult> GLTFImportResultsToMicroBenchmarkResults(const std::vector<GLTFImportResult>& a_results)
+	{
+		std::vector<MicroBenchmarkResult> result;
+		for (const auto& r : a_results) {
+			for (size_t i = 0; i < GLTFImportResult::NUM_PHASES; i++) {
+				const auto phase = static_cast<GLTFImportPhase>(i);
+				result.push_back({ .name = std::format("BM_GLTFImport/{}/{}", r.entry.GetName(), GetPhaseName(phase)),
+					.iterations = r.iterations,
+					.realTimeNs = r.phaseMs[i] * 1'000'000.0,
+					.itemsPerSecond = r.GetKeyframesPerSec(phase),
+					.bytesPerSecond = r.GetMBPerSec(phase) * 1'000'000.0,
+					.error = r.error });
+			}
+		}
+		return result;
+	}
+
+	std::string_view GetPhaseName(GLTFImportPhase a_phase)
+	{
+		switch (a_phase) {
+		case GLTFImportPhase::kDecompress:
+			return "decompress";
+		case GLTFImportPhase::kParse:
+			return "parse";
+		case GLTFImportPhase::kDecode:
+			return "decode";
+		case GLTFImportPhase::kBuild:
+			return "build";
+		default:
+			return "total";
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+#include "MicroBenchmark.h"
+
+namespace Benchmark
+{
+	// Generates a corpus of .glb files through Serialization::GLTFExport and times each phase of the import path that
+	// FileManager runs when loading an animation.
+	struct GLTFImportConfig
+	{
+		std::filesystem::path corpusDir = std::filesystem::temp_directory_path() / "NAF-GLTFCorpus";
+		std::vector<size_t> jointCounts = { 80, 250 };
+		std::vector<float> durations = { 1.0f, 10.0f };
+		std::vector<float> channelDensities = { 0.25f, 1.0f };
+		std::vector<size_t> morphCounts = { 0, 32 };
+		float keysPerSecond = 30.0f;
+		size_t iterations = 5;
+		bool writeGzip = true;
+	};
+
+	struct GLTFCorpusEntry
+	{
+		std::filesystem::path path;
+		size_t numJoints = 0;
+		float duration = 0.0f;
+		size_t numKeys = 0;
+		float channelDensity = 1.0f;
+		size_t numMorphs = 0;
+		bool gzip = false;
+
+		std::string GetName() const;
+	};
+
+	enum class GLTFImportPhase : uint8_t
+	{
+		kDecompress,
+		kParse,
+		kDecode,
+		kBuild,
+
+		kTotal
+	};
+
+	struct GLTFImportResult
+	{
+		static constexpr size_t NUM_PHASES = static_cast<size_t>(GLTFImportPhase::kTotal) + 1;
+
+		GLTFCorpusEntry entry;
+		size_t fileBytes = 0;
+		size_t decodedBytes = 0;
+		size_t keyframes = 0;
+		size_t iterations = 0;
+		std::array<uint64_t, NUM_PHASES> phaseCycles{};
+		std::array<double, NUM_PHASES> phaseMs{};
+		std::string error;
+
+		// Throughput is measured against the decompressed file size for every phase, so phases are directly comparable.
+		double GetMBPerSec(GLTFImportPhase a_phase) const;
+		double GetKeyframesPerSec(GLTFImportPhase a_phase) const;
+		double GetCyclesPerKeyframe(GLTFImportPhase a_phase) const;
+	};
+
+	std::vector<GLTFCorpusEntry> GenerateGLTFCorpus(const GLTFImportConfig& a_config = {});
+	std::vector<GLTFImportResult> RunGLTFImportBenchmark(const GLTFImportConfig& a_config = {});
+	void LogGLTFImportResults(const std::vector<GLTFImportResult>& a_results);
+	// One entry per corpus file and phase, so the results can be written with WriteMicroBenchmarkJson.
+	std::vector<MicroBenchmarkResult> GLTFImportResultsToMicroBenchmarkResults(const std::vector<GLTFImportResult>& a_results);
+	std::string_view GetPhaseName(GLTFImportPhase a_phase);
+}
\ No newline at end of file
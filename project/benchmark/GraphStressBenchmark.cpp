@@ -0,0 +1,261 @@
+#include "GraphStressBenchmark.h"
+#include "StandInActor.h"
+#include "Synthetic.h"
+#include "Util/General.h"
+#include "Util/Memory.h"
+
+namespace Benchmark
+{
+	namespace detail
+	{
+		constexpr size_t UPDATE_BATCH_SIZE = 8;
+
+		struct StressGraph
+		{
+			Util::Locks::Mutex<"Benchmark::StressGraph::lock"> lock;
+			std::unique_ptr<StandInActor> actor;
+		};
+
+		// Stands in for GraphManager::PersistentState and its stateLock.
+		struct StressManager
+		{
+			Util::Locks::Mutex<"Benchmark::StressManager::stateLock", std::shared_mutex> stateLock;
+			std::unordered_map<size_t, std::shared_ptr<StressGraph>> graphs;
+		};
+
+		struct StressFixture
+		{
+			std::shared_ptr<const Animation::OzzSkeleton> skeleton;
+			std::shared_ptr<Animation::OzzAnimation> anim;
+			GraphUpdateConfig updateConfig;
+		};
+
+		struct WorkerStats
+		{
+			uint64_t updates = 0;
+			uint64_t stateWaitTicks = 0;
+			uint64_t graphWaitTicks = 0;
+			std::vector<uint64_t> latencyTicks;
+		};
+
+		std::shared_ptr<StressGraph> CreateGraph(const StressFixture& a_fixture, size_t a_idx)
+		{
+			auto result = std::make_shared<StressGraph>();
+			result->actor = CreateStandInActor(a_fixture.skeleton, a_fixture.anim, a_idx);
+			return result;
+		}
+
+		void UpdateGraph(StressManager& a_manager, size_t a_id, const StressFixture& a_fixture, WorkerStats& a_stats, bool a_record)
+		{
+			const uint64_t start = Util::Profiler::ReadTimestamp();
+			std::shared_lock ls{ a_manager.stateLock };
+			const uint64_t stateAcquired = Util::Profiler::ReadTimestamp();
+
+			auto iter = a_manager.graphs.find(a_id);
+			if (iter == a_manager.graphs.end())
+				return;
+
+			auto& g = iter->second;
+			std::unique_lock l{ g->lock };
+			const uint64_t graphAcquired = Util::Profiler::ReadTimestamp();
+
+			StageTimings timings{};
+			UpdateStandInActor(*g->actor, a_fixture.skeleton.get(), a_fixture.updateConfig, timings);
+			const uint64_t end = Util::Profiler::ReadTimestamp();
+
+			if (a_record) {
+				a_stats.updates++;
+				a_stats.stateWaitTicks += stateAcquired - start;
+				a_stats.graphWaitTicks += graphAcquired - stateAcquired;
+				a_stats.latencyTicks.push_back(end - start);
+			}
+		}
+
+		void RunApiCalls(StressManager& a_manager, const StressFixture& a_fixture, const GraphStressConfig& a_config, size_t a_frame, WorkerStats& a_stats, bool a_record)
+		{
+			const size_t numGraphs = a_config.numGraphs;
+			const size_t replaceInterval = a_config.graphReplacementsPerFrame > 0 ? std::max(a_config.apiVisitsPerFrame / a_config.graphReplacementsPerFrame, 1ui64) : SIZE_MAX;
+
+			for (size_t i = 0; i < a_config.apiVisitsPerFrame; i++) {
+				const size_t id = (a_frame * 7919 + i * 104729) % numGraphs;
+
+				const uint64_t start = Util::Profiler::ReadTimestamp();
+				uint64_t stateAcquired = 0;
+				uint64_t graphAcquired = 0;
+				if (i % replaceInterval == 0) {
+					// GraphManager creates and destroys graphs while holding stateLock exclusively.
+					std::unique_lock l{ a_manager.stateLock };
+					stateAcquired = graphAcquired = Util::Profiler::ReadTimestamp();
+					a_manager.graphs.erase(id);
+					a_manager.graphs.emplace(id, CreateGraph(a_fixture, id));
+				} else {
+					// Equivalent of GraphManager::VisitGraph.
+					std::shared_lock ls{ a_manager.stateLock };
+					stateAcquired = graphAcquired = Util::Profiler::ReadTimestamp();
+					if (auto iter = a_manager.graphs.find(id); iter != a_manager.graphs.end()) {
+						std::unique_lock l{ iter->second->lock };
+						graphAcquired = Util::Profiler::ReadTimestamp();
+						iter->second->actor->generator->speed = 1.0f;
+					}
+				}
+
+				if (a_record) {
+					a_stats.updates++;
+					a_stats.stateWaitTicks += stateAcquired - start;
+					a_stats.graphWaitTicks += graphAcquired - stateAcquired;
+					a_stats.latencyTicks.push_back(Util::Profiler::ReadTimestamp() - start);
+				}
+			}
+		}
+
+		GraphStressResult RunForThreadCount(size_t a_numThreads, const StressFixture& a_fixture, const GraphStressConfig& a_config)
+		{
+			GraphStressResult result;
+			result.numThreads = a_numThreads;
+			result.numGraphs = a_config.numGraphs;
+			result.numFrames = a_config.numFrames;
+
+			StressManager manager;
+			for (size_t i = 0; i < a_config.numGraphs; i++) {
+				manager.graphs.emplace(i, CreateGraph(a_fixture, i));
+			}
+
+			const size_t totalFrames = a_config.warmupFrames + a_config.numFrames;
+			std::vector<WorkerStats> workerStats(a_numThreads);
+			for (auto& s : workerStats) {
+				s.latencyTicks.reserve((a_config.numGraphs * a_config.numFrames) / a_numThreads + UPDATE_BATCH_SIZE);
+			}
+			WorkerStats apiStats;
+			apiStats.latencyTicks.reserve(a_config.apiVisitsPerFrame * a_config.numFrames);
+			std::atomic<size_t> nextGraph{ 0 };
+			std::barrier frameSync(static_cast<ptrdiff_t>(a_numThreads + 2));
+
+			std::vector<std::jthread> threads;
+			for (size_t t = 0; t < a_numThreads; t++) {
+				threads.emplace_back([&, t]() {
+					auto& stats = workerStats[t];
+					for (size_t f = 0; f < totalFrames; f++) {
+						frameSync.arrive_and_wait();
+						const bool record = f >= a_config.warmupFrames;
+						while (true) {
+							const size_t begin = nextGraph.fetch_add(UPDATE_BATCH_SIZE, std::memory_order_relaxed);
+							if (begin >= a_config.numGraphs)
+								break;
+
+							const size_t end = std::min(begin + UPDATE_BATCH_SIZE, a_config.numGraphs);
+							for (size_t id = begin; id < end; id++) {
+								UpdateGraph(manager, id, a_fixture, stats, record);
+							}
+						}
+						frameSync.arrive_and_wait();
+					}
+				});
+			}
+
+			threads.emplace_back([&]() {
+				for (size_t f = 0; f < totalFrames; f++) {
+					frameSync.arrive_and_wait();
+					RunApiCalls(manager, a_fixture, a_config, f, apiStats, f >= a_config.warmupFrames);
+					frameSync.arrive_and_wait();
+				}
+			});
+
+			std::chrono::steady_clock::time_point measureStart;
+			for (size_t f = 0; f < totalFrames; f++) {
+				if (f == a_config.warmupFrames) {
+					measureStart = std::chrono::steady_clock::now();
+				}
+				nextGraph.store(0, std::memory_order_relaxed);
+				frameSync.arrive_and_wait();
+				frameSync.arrive_and_wait();
+			}
+			result.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - measureStart).count();
+			threads.clear();
+
+			std::vector<uint64_t> latencies;
+			for (auto& s : workerStats) {
+				result.updates += s.updates;
+				result.stateLockWaitMs += Util::Profiler::TicksToMs(s.stateWaitTicks);
+				result.graphLockWaitMs += Util::Profiler::TicksToMs(s.graphWaitTicks);
+				latencies.insert(latencies.end(), s.latencyTicks.begin(), s.latencyTicks.end());
+			}
+
+			if (!latencies.empty()) {
+				const auto Percentile = [&](double a_p) {
+					const size_t idx = std::min(static_cast<size_t>(a_p * static_cast<double>(latencies.size())), latencies.size() - 1);
+					std::nth_element(latencies.begin(), latencies.begin() + idx, latencies.end());
+					return Util::Profiler::TicksToMs(latencies[idx]) * 1000.0;
+				};
+				result.p50Us = Percentile(0.5);
+				result.p99Us = Percentile(0.99);
+				result.p999Us = Percentile(0.999);
+				result.maxUs = Util::Profiler::TicksToMs(*std::max_element(latencies.begin(), latencies.end())) * 1000.0;
+			}
+
+			result.apiCalls = apiStats.updates;
+			result.apiStateLockWaitMs = Util::Profiler::TicksToMs(apiStats.stateWaitTicks);
+			result.apiGraphLockWaitMs = Util::Profiler::TicksToMs(apiStats.graphWaitTicks);
+			if (!apiStats.latencyTicks.empty()) {
+				result.apiMaxUs = Util::Profiler::TicksToMs(*std::max_element(apiStats.latencyTicks.begin(), apiStats.latencyTicks.end())) * 1000.0;
+			}
+
+			return result;
+		}
+	}
+
+	double GraphStressResult::GetUpdatesPerSec() const
+	{
+		return wallMs > 0.0 ? static_cast<double>(updates) / (wallMs / 1000.0) : 0.0;
+	}
+
+	double GraphStressResult::GetScalingEfficiency(const GraphStressResult& a_baseline) const
+	{
+		const double baseline = a_baseline.GetUpdatesPerSec();
+		if (baseline <= 0.0 || a_baseline.numThreads == 0)
+			return 0.0;
+
+		const double threadRatio = static_cast<double>(numThreads) / static_cast<double>(a_baseline.numThreads);
+		return (GetUpdatesPerSec() / baseline) / threadRatio;
+	}
+
+	std::vector<GraphStressResult> RunGraphStressBenchmark(const GraphStressConfig& a_config)
+	{
+		Util::Memory::InstallOzzAllocator();
+		std::vector<GraphStressResult> results;
+		if (a_config.numGraphs == 0)
+			return results;
+
+		detail::StressFixture fixture;
+		fixture.skeleton = CreateSkeleton(a_config.numBones);
+		if (!fixture.skeleton) {
+			logger::warn("Graph stress benchmark: failed to build a skeleton with {} bones.", a_config.numBones);
+			return results;
+		}
+
+		fixture.anim = CreateAnimation(fixture.skeleton.get(), 2.0f, 30);
+		if (!fixture.anim) {
+			logger::warn("Graph stress benchmark: failed to build an animation for {} bones.", a_config.numBones);
+			return results;
+		}
+		fixture.updateConfig.deltaTime = a_config.deltaTime;
+
+		for (const size_t numThreads : a_config.threadCounts) {
+			if (numThreads == 0)
+				continue;
+
+			results.push_back(detail::RunForThreadCount(numThreads, fixture, a_config));
+		}
+		return results;
+	}
+
+	void LogGraphStressResults(const std::vector<GraphStressResult>& a_results)
+	{
+		for (const auto& r : a_results) {
+			logger::info("Graph stress benchmark: {} threads, {} graphs, {} frames", r.numThreads, r.numGraphs, r.numFrames);
+			logger::info("    {:>12.0f} updates/sec {:>8.2f} scaling efficiency", r.GetUpdatesPerSec(), a_results.empty() ? 0.0 : r.GetScalingEfficiency(a_results.front()));
+			logger::info("    lock wait: {:.3f} ms stateLock, {:.3f} ms graph lock", r.stateLockWaitMs, r.graphLockWaitMs);
+			logger::info("    latency: p50 {:.2f} us, p99 {:.2f} us, p99.9 {:.2f} us, max {:.2f} us", r.p50Us, r.p99Us, r.p999Us, r.maxUs);
+			logger::info("    api thread: {} calls, lock wait {:.3f} ms stateLock, {:.3f} ms graph lock, max {:.2f} us", r.apiCalls, r.apiStateLockWaitMs, r.apiGraphLockWaitMs, r.apiMaxUs);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+namespace Benchmark
+{
+	// Drives thousands of stand-in graphs from a pool of worker threads the way the game's parallel animation update does:
+	// each update takes the manager's state lock shared, then the graph's own lock exclusively. A separate thread plays the
+	// part of the script API, visiting graphs and occasionally replacing one under an exclusive state lock.
+	struct GraphStressConfig
+	{
+		std::vector<size_t> threadCounts = { 1, 2, 4, 8, 16 };
+		size_t numGraphs = 2000;
+		size_t numBones = 80;
+		size_t numFrames = 120;
+		size_t warmupFrames = 10;
+		size_t apiVisitsPerFrame = 200;
+		size_t graphReplacementsPerFrame = 2;
+		float deltaTime = 1.0f / 60.0f;
+	};
+
+	struct GraphStressResult
+	{
+		size_t numThreads = 0;
+		size_t numGraphs = 0;
+		size_t numFrames = 0;
+		uint64_t updates = 0;
+		double wallMs = 0.0;
+		double stateLockWaitMs = 0.0;
+		double graphLockWaitMs = 0.0;
+		// Per-graph update latency, including lock acquisition.
+		double p50Us = 0.0;
+		double p99Us = 0.0;
+		double p999Us = 0.0;
+		double maxUs = 0.0;
+		// Script API thread: graph visits and replacements, and how long they waited on each lock.
+		uint64_t apiCalls = 0;
+		double apiStateLockWaitMs = 0.0;
+		double apiGraphLockWaitMs = 0.0;
+		double apiMaxUs = 0.0;
+
+		double GetUpdatesPerSec() const;
+		// Throughput relative to a_baseline, divided by the thread ratio. 1.0 is perfectly linear scaling.
+		double GetScalingEfficiency(const GraphStressResult& a_baseline) const;
+	};
+
+	std::vector<GraphStressResult> RunGraphStressBenchmark(const GraphStressConfig& a_config = {});
+	void LogGraphStressResults(const std::vector<GraphStressResult>& a_results);
+}
\ No newline at end of file
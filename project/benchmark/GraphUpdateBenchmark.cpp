@@ -0,0 +1,102 @@
+#include "GraphUpdateBenchmark.h"
+#include "StandInActor.h"
+#include "Synthetic.h"
+#include "Util/Memory.h"
+
+namespace Benchmark
+{
+	namespace detail
+	{
+		GraphUpdateResult RunForBoneCount(size_t a_numBones, const GraphUpdateConfig& a_config)
+		{
+			GraphUpdateResult result;
+			auto skeleton = CreateSkeleton(a_numBones);
+			if (!skeleton) {
+				logger::warn("Graph update benchmark: failed to build a skeleton with {} bones.", a_numBones);
+				return result;
+			}
+
+			auto anim = CreateAnimation(skeleton.get(), a_config.animationDuration, a_config.animationKeys);
+			if (!anim) {
+				logger::warn("Graph update benchmark: failed to build an animation for {} bones.", a_numBones);
+				return result;
+			}
+
+			std::vector<std::unique_ptr<StandInActor>> actors;
+			actors.reserve(a_config.numActors);
+			for (size_t i = 0; i < a_config.numActors; i++) {
+				actors.push_back(CreateStandInActor(skeleton, anim, i));
+			}
+
+			result.numBones = skeleton->data->num_joints();
+			result.numActors = a_config.numActors;
+			result.numFrames = a_config.numFrames;
+
+			StageTimings warmupTimings{};
+			for (size_t i = 0; i < a_config.warmupFrames; i++) {
+				for (auto& a : actors) {
+					UpdateStandInActor(*a, skeleton.get(), a_config, warmupTimings);
+				}
+			}
+
+			for (size_t i = 0; i < a_config.numFrames; i++) {
+				for (auto& a : actors) {
+					UpdateStandInActor(*a, skeleton.get(), a_config, result.stageNs);
+				}
+			}
+
+			return result;
+		}
+	}
+
+	double GraphUpdateResult::GetFramesPerSec(GraphUpdateStage a_stage) const
+	{
+		const double ns = stageNs[static_cast<size_t>(a_stage)];
+		return ns > 0.0 ? static_cast<double>(numFrames) / (ns * 1e-9) : 0.0;
+	}
+
+	double GraphUpdateResult::GetNsPerBone(GraphUpdateStage a_stage) const
+	{
+		const double numBoneUpdates = static_cast<double>(numFrames * numActors * numBones);
+		return numBoneUpdates > 0.0 ? stageNs[static_cast<size_t>(a_stage)] / numBoneUpdates : 0.0;
+	}
+
+	std::vector<GraphUpdateResult> RunGraphUpdateBenchmark(const GraphUpdateConfig& a_config)
+	{
+		Util::Memory::InstallOzzAllocator();
+		std::vector<GraphUpdateResult> results;
+		for (size_t numBones : a_config.boneCounts) {
+			results.push_back(detail::RunForBoneCount(numBones, a_config));
+		}
+		return results;
+	}
+
+	void LogGraphUpdateResults(const std::vector<GraphUpdateResult>& a_results)
+	{
+		for (const auto& r : a_results) {
+			logger::info("Graph update benchmark: {} bones, {} actors, {} frames", r.numBones, r.numActors, r.numFrames);
+			for (size_t i = 0; i < GraphUpdateResult::NUM_STAGES; i++) {
+				const auto stage = static_cast<GraphUpdateStage>(i);
+				logger::info("    {:<16} {:>12.1f} frames/sec {:>10.3f} ns/bone", GetStageName(stage), r.GetFramesPerSec(stage), r.GetNsPerBone(stage));
+			}
+		}
+	}
+
+	std::string_view GetStageName(GraphUpdateStage a_stage)
+	{
+		switch (a_stage) {
+		case GraphUpdateStage::kGenerate:
+			return "generate";
+		case GraphUpdateStage::kTransitionBlend:
+			return "transition_blend";
+		case GraphUpdateStage::kPostGenJobs:
+			return "post_gen_jobs";
+		case GraphUpdateStage::kUnpack:
+			return "unpack";
+		case GraphUpdateStage::kCopyOut:
+			return "copy_out";
+		default:
+			return "total";
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+namespace Benchmark
+{
+	// Runs the per-frame pose pipeline of Animation::Graph::Update against synthetic skeletons and stand-in game transforms,
+	// so it can be measured without loaded 3D, NiNodes or a live reference.
+	struct GraphUpdateConfig
+	{
+		std::vector<size_t> boneCounts = { 80, 250, 600 };
+		size_t numActors = 32;
+		size_t numFrames = 600;
+		size_t warmupFrames = 60;
+		size_t animationKeys = 30;
+		float animationDuration = 2.0f;
+		float deltaTime = 1.0f / 60.0f;
+		bool transitioning = true;
+		bool postGenJobs = true;
+	};
+
+	enum class GraphUpdateStage : uint8_t
+	{
+		kGenerate,
+		kTransitionBlend,
+		kPostGenJobs,
+		kUnpack,
+		kCopyOut,
+
+		kTotal
+	};
+
+	struct GraphUpdateResult
+	{
+		static constexpr size_t NUM_STAGES = static_cast<size_t>(GraphUpdateStage::kTotal) + 1;
+
+		size_t numBones = 0;
+		size_t numActors = 0;
+		size_t numFrames = 0;
+		std::array<double, NUM_STAGES> stageNs{};
+
+		double GetFramesPerSec(GraphUpdateStage a_stage = GraphUpdateStage::kTotal) const;
+		double GetNsPerBone(GraphUpdateStage a_stage) const;
+	};
+
+	std::vector<GraphUpdateResult> RunGraphUpdateBenchmark(const GraphUpdateConfig& a_config = {});
+	void LogGraphUpdateResults(const std::vector<GraphUpdateResult>& a_results);
+	std::string_view GetStageName(GraphUpdateStage a_stage);
+}
\ No newline at end of file
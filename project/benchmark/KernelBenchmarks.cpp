@@ -0,0 +1,164 @@
+#include "KernelBenchmarks.h"
+#include "Synthetic.h"
+#include "Animation/Transform.h"
+#include "Util/Ozz.h"
+
+namespace Benchmark
+{
+	namespace detail
+	{
+		struct KernelFixture
+		{
+			std::shared_ptr<const Animation::OzzSkeleton> skeleton;
+			std::vector<ozz::math::SoaTransform> soaTransforms;
+			std::vector<ozz::math::Float4x4> matrices;
+			std::vector<ozz::math::Float4x4*> matrixPtrs;
+			std::vector<Animation::Transform> transforms;
+		};
+
+		std::map<int64_t, std::unique_ptr<KernelFixture>> fixtures;
+
+		KernelFixture* GetFixture(State& a_state)
+		{
+			const int64_t numJoints = a_state.GetArg();
+			if (auto iter = fixtures.find(numJoints); iter != fixtures.end()) {
+				return iter->second.get();
+			}
+
+			auto skeleton = CreateSkeleton(static_cast<size_t>(numJoints));
+			if (!skeleton) {
+				a_state.SkipWithError("Failed to build skeleton.");
+				return nullptr;
+			}
+
+			auto f = std::make_unique<KernelFixture>();
+			const auto restPoses = skeleton->data->joint_rest_poses();
+			f->soaTransforms.assign(restPoses.begin(), restPoses.end());
+			f->matrices = CreateStandInTransforms(skeleton.get());
+			for (auto& m : f->matrices) {
+				f->matrixPtrs.push_back(&m);
+			}
+			for (int i = 0; i < skeleton->data->num_joints(); i++) {
+				f->transforms.emplace_back(ozz::animation::GetJointLocalRestPose(*skeleton->data, i));
+			}
+			f->skeleton = std::move(skeleton);
+
+			return fixtures.emplace(numJoints, std::move(f)).first->second.get();
+		}
+
+		void SetProcessed(State& a_state, size_t a_bytesPerIteration)
+		{
+			const int64_t iterations = static_cast<int64_t>(a_state.GetIterations());
+			a_state.SetItemsProcessed(iterations * a_state.GetArg());
+			a_state.SetBytesProcessed(iterations * static_cast<int64_t>(a_bytesPerIteration));
+		}
+
+		void BM_UnpackSoaTransforms(State& a_state)
+		{
+			auto f = GetFixture(a_state);
+			if (!f)
+				return;
+
+			while (a_state.KeepRunning()) {
+				Util::Ozz::UnpackSoaTransforms(f->soaTransforms, f->matrices, f->skeleton->data.get());
+				ClobberMemory();
+			}
+			SetProcessed(a_state, std::span(f->soaTransforms).size_bytes() + std::span(f->matrices).size_bytes());
+		}
+
+		void BM_PackSoaTransforms_Float4x4(State& a_state)
+		{
+			auto f = GetFixture(a_state);
+			if (!f)
+				return;
+
+			while (a_state.KeepRunning()) {
+				Util::Ozz::PackSoaTransforms(f->matrices, f->soaTransforms, f->skeleton->data.get());
+				ClobberMemory();
+			}
+			SetProcessed(a_state, std::span(f->soaTransforms).size_bytes() + std::span(f->matrices).size_bytes());
+		}
+
+		void BM_PackSoaTransforms_Transform(State& a_state)
+		{
+			auto f = GetFixture(a_state);
+			if (!f)
+				return;
+
+			while (a_state.KeepRunning()) {
+				Util::Ozz::PackSoaTransforms(f->transforms, f->soaTransforms, f->skeleton->data.get());
+				ClobberMemory();
+			}
+			SetProcessed(a_state, std::span(f->soaTransforms).size_bytes() + std::span(f->transforms).size_bytes());
+		}
+
+		void BM_PackRestPose(State& a_state)
+		{
+			auto f = GetFixture(a_state);
+			if (!f)
+				return;
+
+			while (a_state.KeepRunning()) {
+				Util::Ozz::PackRestPose(f->matrixPtrs, f->skeleton->controlledByGameMask, f->soaTransforms, f->skeleton->data.get());
+				ClobberMemory();
+			}
+			SetProcessed(a_state, std::span(f->soaTransforms).size_bytes() + std::span(f->matrices).size_bytes());
+		}
+
+		void BM_ExtractSoaTransforms(State& a_state)
+		{
+			auto f = GetFixture(a_state);
+			if (!f)
+				return;
+
+			auto& out = f->transforms;
+			const size_t numJoints = out.size();
+			while (a_state.KeepRunning()) {
+				Animation::Transform::ExtractSoaTransforms(f->soaTransforms, [&](size_t a_idx, const Animation::Transform& a_transform) {
+					if (a_idx < numJoints) {
+						out[a_idx] = a_transform;
+					}
+				});
+				ClobberMemory();
+			}
+			SetProcessed(a_state, std::span(f->soaTransforms).size_bytes() + std::span(f->transforms).size_bytes());
+		}
+
+		void BM_StoreSoaTransforms(State& a_state)
+		{
+			auto f = GetFixture(a_state);
+			if (!f)
+				return;
+
+			const auto& in = f->transforms;
+			const size_t numJoints = in.size();
+			while (a_state.KeepRunning()) {
+				Animation::Transform::StoreSoaTransforms(f->soaTransforms, [&](size_t a_idx) {
+					return a_idx < numJoints ? in[a_idx] : Animation::Transform();
+				});
+				ClobberMemory();
+			}
+			SetProcessed(a_state, std::span(f->soaTransforms).size_bytes() + std::span(f->transforms).size_bytes());
+		}
+	}
+
+	std::vector<MicroBenchmark> GetKernelBenchmarks(const std::vector<int64_t>& a_jointCounts)
+	{
+		return {
+			{ "BM_UnpackSoaTransforms", &detail::BM_UnpackSoaTransforms, a_jointCounts },
+			{ "BM_PackSoaTransforms_Float4x4", &detail::BM_PackSoaTransforms_Float4x4, a_jointCounts },
+			{ "BM_PackSoaTransforms_Transform", &detail::BM_PackSoaTransforms_Transform, a_jointCounts },
+			{ "BM_PackRestPose", &detail::BM_PackRestPose, a_jointCounts },
+			{ "BM_ExtractSoaTransforms", &detail::BM_ExtractSoaTransforms, a_jointCounts },
+			{ "BM_StoreSoaTransforms", &detail::BM_StoreSoaTransforms, a_jointCounts }
+		};
+	}
+
+	std::vector<MicroBenchmarkResult> RunKernelBenchmarks(const MicroBenchmarkConfig& a_config, const std::vector<int64_t>& a_jointCounts)
+	{
+		auto benchmarks = GetKernelBenchmarks(a_jointCounts);
+		auto results = RunMicroBenchmarks(benchmarks, a_config);
+		detail::fixtures.clear();
+		return results;
+	}
+}
\ No newline at end of file
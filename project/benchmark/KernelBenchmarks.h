@@ -0,0 +1,11 @@
+#pragma once
+#include "MicroBenchmark.h"
+
+namespace Benchmark
+{
+	// Joint counts include non-multiples of 4 so the partial SoA tail of each kernel is exercised.
+	inline const std::vector<int64_t> DEFAULT_KERNEL_JOINT_COUNTS = { 1, 3, 4, 5, 61, 80, 250, 599, 600 };
+
+	std::vector<MicroBenchmark> GetKernelBenchmarks(const std::vector<int64_t>& a_jointCounts = DEFAULT_KERNEL_JOINT_COUNTS);
+	std::vector<MicroBenchmarkResult> RunKernelBenchmarks(const MicroBenchmarkConfig& a_config = {}, const std::vector<int64_t>& a_jointCounts = DEFAULT_KERNEL_JOINT_COUNTS);
+}
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include "MicroBenchmark.h"
+
+namespace Benchmark
+{
+	State::State(int64_t a_arg, uint64_t a_maxIterations) :
+		_arg(a_arg), _maxIterations(a_maxIterations)
+	{
+	}
+
+	bool State::KeepRunning()
+	{
+		if (!_running) {
+			if (_iterations > 0 || !_error.empty()) {
+				return false;
+			}
+			_running = true;
+			_start = Clock::now();
+		}
+
+		if (_iterations < _maxIterations && _error.empty()) {
+			_iterations++;
+			return true;
+		}
+
+		_elapsed += Clock::now() - _start;
+		_running = false;
+		return false;
+	}
+
+	void State::PauseTiming()
+	{
+		_elapsed += Clock::now() - _start;
+	}
+
+	void State::ResumeTiming()
+	{
+		_start = Clock::now();
+	}
+
+	void State::SetItemsProcessed(int64_t a_items)
+	{
+		_items = a_items;
+	}
+
+	void State::SetBytesProcessed(int64_t a_bytes)
+	{
+		_bytes = a_bytes;
+	}
+
+	void State::SkipWithError(const std::string_view a_error)
+	{
+		_error = a_error;
+	}
+
+	int64_t State::GetArg() const
+	{
+		return _arg;
+	}
+
+	uint64_t State::GetIterations() const
+	{
+		return _iterations;
+	}
+
+	double State::GetElapsedNs() const
+	{
+		return std::chrono::duration<double, std::nano>(_elapsed).count();
+	}
+
+	int64_t State::GetItemsProcessed() const
+	{
+		return _items;
+	}
+
+	int64_t State::GetBytesProcessed() const
+	{
+		return _bytes;
+	}
+
+	const std::string& State::GetError() const
+	{
+		return _error;
+	}
+
+	namespace detail
+	{
+		MicroBenchmarkResult RunSingle(const std::string& a_name, BenchmarkFunc a_func, int64_t a_arg, const MicroBenchmarkConfig& a_config)
+		{
+			MicroBenchmarkResult result;
+			result.name = a_name;
+
+			const double minTimeNs = std::chrono::duration<double, std::nano>(a_config.minTime).count();
+			uint64_t iterations = 1;
+
+			while (true) {
+				State state(a_arg, iterations);
+				a_func(state);
+
+				if (!state.GetError().empty()) {
+					result.error = state.GetError();
+					return result;
+				}
+
+				const double elapsed = state.GetElapsedNs();
+				if (elapsed >= minTimeNs || iterations >= a_config.maxIterations) {
+					const double seconds = elapsed * 1e-9;
+					result.iterations = state.GetIterations();
+					result.realTimeNs = result.iterations > 0 ? elapsed / static_cast<double>(result.iterations) : 0.0;
+					result.itemsPerSecond = seconds > 0.0 ? static_cast<double>(state.GetItemsProcessed()) / seconds : 0.0;
+					result.bytesPerSecond = seconds > 0.0 ? static_cast<double>(state.GetBytesProcessed()) / seconds : 0.0;
+					return result;
+				}
+
+				// Same growth heuristic as Google Benchmark: aim 40% past the minimum time, but never grow more than 10x at once.
+				double multiplier = elapsed > 0.0 ? (minTimeNs * 1.4) / elapsed : 10.0;
+				multiplier = std::clamp(multiplier, 2.0, 10.0);
+				iterations = std::min(static_cast<uint64_t>(static_cast<double>(iterations) * multiplier), a_config.maxIterations);
+			}
+		}
+	}
+
+	std::vector<MicroBenchmarkResult> RunMicroBenchmarks(const std::span<const MicroBenchmark>& a_benchmarks, const MicroBenchmarkConfig& a_config)
+	{
+		std::vector<MicroBenchmarkResult> results;
+		std::optional<std::regex> filter;
+		if (!a_config.filter.empty()) {
+			filter.emplace(a_config.filter);
+		}
+
+		for (const auto& b : a_benchmarks) {
+			for (int64_t arg : b.args) {
+				std::string name = std::format("{}/{}", b.name, arg);
+				if (filter.has_value() && !std::regex_search(name, filter.value())) {
+					continue;
+				}
+				results.push_back(detail::RunSingle(name, b.func, arg, a_config));
+			}
+		}
+
+		return results;
+	}
+
+	std::string EscapeJson(const std::string_view a_str)
+	{
+		std::string result;
+		result.reserve(a_str.size());
+		for (char c : a_str) {
+			switch (c) {
+			case '"':
+				result += "\\\"";
+				break;
+			case '\\':
+				result += "\\\\";
+				break;
+			case '\n':
+				result += "\\n";
+				break;
+			default:
+				result += c;
+				break;
+			}
+		}
+		return result;
+	}
+
+	std::string MicroBenchmarkResultsToJson(const std::vector<MicroBenchmarkResult>& a_results)
+	{
+		std::string result;
+		result += "{\n";
+		result += "  \"context\": {\n";
+		result += std::format("    \"date\": \"{:%FT%T}\",\n", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+		result += std::format("    \"num_cpus\": {},\n", std::thread::hardware_concurrency());
+#ifdef NDEBUG
+		result += "    \"library_build_type\": \"release\"\n";
+#else
+		result += "    \"library_build_type\": \"debug\"\n";
+#endif
+		result += "  },\n";
+		result += "  \"benchmarks\": [";
+
+		for (size_t i = 0; i < a_results.size(); i++) {
+			const auto& r = a_results[i];
+			const std::string name = EscapeJson(r.name);
+			result += i > 0 ? ",\n" : "\n";
+			result += "    {\n";
+			result += std::format("      \"name\": \"{}\",\n", name);
+			result += std::format("      \"run_name\": \"{}\",\n", name);
+			result += "      \"run_type\": \"iteration\",\n";
+			if (!r.error.empty()) {
+				result += "      \"error_occurred\": true,\n";
+				result += std::format("      \"error_message\": \"{}\",\n", EscapeJson(r.error));
+			}
+			result += std::format("      \"iterations\": {},\n", r.iterations);
+			result += std::format("      \"real_time\": {:.6f},\n", r.realTimeNs);
+			result += std::format("      \"cpu_time\": {:.6f},\n", r.realTimeNs);
+			result += "      \"time_unit\": \"ns\"";
+			if (r.bytesPerSecond > 0.0) {
+				result += std::format(",\n      \"bytes_per_second\": {:.6f}", r.bytesPerSecond);
+			}
+			if (r.itemsPerSecond > 0.0) {
+				result += std::format(",\n      \"items_per_second\": {:.6f}", r.itemsPerSecond);
+			}
+			result += "\n    }";
+		}
+
+		result += "\n  ]\n}\n";
+		return result;
+	}
+
+	bool WriteMicroBenchmarkJson(const std::filesystem::path& a_path, const std::vector<MicroBenchmarkResult>& a_results)
+	{
+		std::ofstream file(a_path, std::ios::out | std::ios::trunc);
+		if (!file.good()) {
+			logger::warn("Failed to open {} for writing benchmark results.", a_path.generic_string());
+			return false;
+		}
+
+		file << MicroBenchmarkResultsToJson(a_results);
+		return file.good();
+	}
+
+	void LogMicroBenchmarkResults(const std::vector<MicroBenchmarkResult>& a_results)
+	{
+		for (const auto& r : a_results) {
+			if (!r.error.empty()) {
+				logger::warn("{:<48} error: {}", r.name, r.error);
+				continue;
+			}
+			logger::info("{:<48} {:>12.1f} ns {:>14} iterations {:>14.0f} items/s", r.name, r.realTimeNs, r.iterations, r.itemsPerSecond);
+		}
+	}
+}
\ No newline at end of file
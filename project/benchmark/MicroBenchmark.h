@@ -0,0 +1,94 @@
+#pragma once
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Benchmark
+{
+	// A minimal runner modelled on Google Benchmark: each benchmark receives a State, loops while KeepRunning() is true,
+	// and the runner scales the iteration count until a run takes at least the minimum time.
+	class State
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		State(int64_t a_arg, uint64_t a_maxIterations);
+
+		bool KeepRunning();
+		void PauseTiming();
+		void ResumeTiming();
+		void SetItemsProcessed(int64_t a_items);
+		void SetBytesProcessed(int64_t a_bytes);
+		void SkipWithError(const std::string_view a_error);
+
+		int64_t GetArg() const;
+		uint64_t GetIterations() const;
+		double GetElapsedNs() const;
+		int64_t GetItemsProcessed() const;
+		int64_t GetBytesProcessed() const;
+		const std::string& GetError() const;
+
+	private:
+		int64_t _arg;
+		uint64_t _maxIterations;
+		uint64_t _iterations = 0;
+		int64_t _items = 0;
+		int64_t _bytes = 0;
+		std::string _error;
+		Clock::time_point _start;
+		Clock::duration _elapsed{ 0 };
+		bool _running = false;
+	};
+
+	using BenchmarkFunc = void (*)(State&);
+
+	struct MicroBenchmark
+	{
+		std::string name;
+		BenchmarkFunc func;
+		std::vector<int64_t> args;
+	};
+
+	struct MicroBenchmarkResult
+	{
+		std::string name;
+		uint64_t iterations = 0;
+		double realTimeNs = 0.0;
+		double itemsPerSecond = 0.0;
+		double bytesPerSecond = 0.0;
+		std::string error;
+	};
+
+	struct MicroBenchmarkConfig
+	{
+		std::chrono::milliseconds minTime{ 500 };
+		uint64_t maxIterations = 1'000'000'000;
+		std::string filter;
+	};
+
+	// Compiler barrier: every write made before the call is treated as observable, so benchmarked stores to memory that's
+	// never read back can't be removed as dead.
+	inline void ClobberMemory()
+	{
+#ifdef _MSC_VER
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : : "memory");
+#endif
+	}
+
+	template <typename T>
+	inline void DoNotOptimize(const T& a_value)
+	{
+		static_cast<void>(*reinterpret_cast<const volatile char*>(std::addressof(a_value)));
+		ClobberMemory();
+	}
+
+	std::vector<MicroBenchmarkResult> RunMicroBenchmarks(const std::span<const MicroBenchmark>& a_benchmarks, const MicroBenchmarkConfig& a_config = {});
+
+	// Serializes results in Google Benchmark's JSON output format, so existing comparison tooling can consume them.
+	std::string MicroBenchmarkResultsToJson(const std::vector<MicroBenchmarkResult>& a_results);
+	bool WriteMicroBenchmarkJson(const std::filesystem::path& a_path, const std::vector<MicroBenchmarkResult>& a_results);
+	void LogMicroBenchmarkResults(const std::vector<MicroBenchmarkResult>& a_results);
+	std::string EscapeJson(const std::string_view a_str);
+}
\ No newline at end of file
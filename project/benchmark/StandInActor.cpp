@@ -0,0 +1,158 @@
+#include "StandInActor.h"
+#include "Synthetic.h"
+#include "Util/Ozz.h"
+
+namespace Benchmark
+{
+	namespace detail
+	{
+		using Clock = std::chrono::steady_clock;
+
+		constexpr float TRANSITION_DURATION = 1.0f;
+
+		template <typename F>
+		inline void TimeStage(StageTimings& a_timings, GraphUpdateStage a_stage, F&& a_func)
+		{
+			const auto start = Clock::now();
+			a_func();
+			a_timings[static_cast<size_t>(a_stage)] += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+		}
+	}
+
+	std::unique_ptr<StandInActor> CreateStandInActor(const std::shared_ptr<const Animation::OzzSkeleton>& a_skeleton, const std::shared_ptr<Animation::OzzAnimation>& a_anim, size_t a_idx)
+	{
+		auto result = std::make_unique<StandInActor>();
+		auto& a = *result;
+		const auto skeleton = a_skeleton->data.get();
+		const auto restPoses = skeleton->joint_rest_poses();
+
+		a.lastOutput.resize(skeleton->num_joints(), ozz::math::Float4x4::identity());
+		a.boneMask = a_skeleton->defaultBoneMask;
+		a.poseCache.set_pose_size(skeleton->num_soa_joints());
+		a.poseCache.reserve(4);
+		a.restPose = a.poseCache.acquire_handle();
+		a.blendedPose = a.poseCache.acquire_handle();
+		std::copy(restPoses.begin(), restPoses.end(), a.restPose.get().begin());
+		a.snapshotPose.encode({ restPoses.begin(), restPoses.size() });
+		a.blendLayers[0].weight = .0f;
+		a.blendLayers[1].weight = .0f;
+
+		a.gameTransforms = CreateStandInTransforms(a_skeleton.get());
+		a.transforms.reserve(a.gameTransforms.size());
+		for (auto& t : a.gameTransforms) {
+			a.transforms.push_back(&t);
+		}
+
+		a.rootMatrix = ozz::math::Float4x4::Translation(ozz::math::simd_float4::Load(static_cast<float>(a_idx), 0.0f, 0.0f, 1.0f));
+		a.prevRootMatrix = a.rootMatrix;
+
+		a.generator = std::make_unique<Animation::LinearClipGenerator>(a_anim);
+		a.generator->SetContext({
+			.modelSpaceCache = a.lastOutput,
+			.prevRootTransform = &a.prevRootMatrix,
+			.rootTransform = &a.rootMatrix,
+			.restPose = &a.restPose,
+			.skeleton = a_skeleton.get(),
+			.physSystem = nullptr
+		});
+
+		// Stagger actors so they don't all sample the same keyframes.
+		a.generator->localTime = std::fmod(static_cast<float>(a_idx) * 0.137f, 1.0f);
+		a.transitionTime = std::fmod(static_cast<float>(a_idx) * 0.25f, detail::TRANSITION_DURATION);
+
+		auto ikNodes = Util::Ozz::GetJointIndexes(skeleton, GetBoneName(2), GetBoneName(3), GetBoneName(4));
+		if (ikNodes.has_value()) {
+			a.ikJob = std::make_unique<Animation::IKTwoBoneJob>();
+			a.ikJob->start_node = ikNodes.value()[0];
+			a.ikJob->mid_node = ikNodes.value()[1];
+			a.ikJob->end_node = ikNodes.value()[2];
+			a.ikJob->target = { static_cast<float>(a_idx) + 0.1f, 0.15f, 0.05f };
+			a.ikJob->poleDir = { 0.0f, 0.0f, 1.0f };
+		}
+
+		return result;
+	}
+
+	void UpdateStandInActor(StandInActor& a_actor, const Animation::OzzSkeleton* a_skeleton, const GraphUpdateConfig& a_config, StageTimings& a_timings)
+	{
+		auto& a = a_actor;
+		const float deltaTime = a_config.deltaTime;
+		const auto start = detail::Clock::now();
+
+		std::span<ozz::math::SoaTransform> output;
+		detail::TimeStage(a_timings, GraphUpdateStage::kGenerate, [&]() {
+			a.generator->AdvanceTime(deltaTime);
+			output = a.generator->Generate(a.poseCache, nullptr);
+		});
+
+		if (a_config.transitioning) {
+			detail::TimeStage(a_timings, GraphUpdateStage::kTransitionBlend, [&]() {
+				a.transitionTime += deltaTime;
+				if (a.transitionTime > detail::TRANSITION_DURATION) {
+					a.transitionTime = 0.0f;
+				}
+
+				auto blendPose = a.blendedPose.get();
+				auto& blendLayers = a.blendLayers;
+				blendLayers[0].transform = ozz::make_span(output);
+				Animation::PoseCache::Handle snapshotPose = a.poseCache.acquire_handle();
+				a.snapshotPose.decode(snapshotPose.get());
+				blendLayers[1].transform = snapshotPose.get_ozz();
+
+				ozz::animation::BlendingJob blendJob;
+				blendJob.rest_pose = a.restPose.get_ozz();
+				blendJob.layers = ozz::make_span(blendLayers);
+				blendJob.output = ozz::make_span(blendPose);
+				blendJob.threshold = 1.0f;
+
+				float normalizedTime = a.ease(a.transitionTime / detail::TRANSITION_DURATION);
+				blendLayers[0].weight = normalizedTime;
+				blendLayers[1].weight = 1.0f - normalizedTime;
+
+				blendJob.Run();
+				output = blendPose;
+			});
+		}
+
+		if (a_config.postGenJobs && a.ikJob) {
+			detail::TimeStage(a_timings, GraphUpdateStage::kPostGenJobs, [&]() {
+				ozz::animation::LocalToModelJob l2mJob;
+				l2mJob.skeleton = a_skeleton->data.get();
+				l2mJob.input = ozz::make_span(output);
+				l2mJob.output = ozz::make_span(a.lastOutput);
+				l2mJob.Run();
+
+				ozz::math::SimdInt4 invertible;
+				Animation::IPostGenJob::Context ctxt{
+					.localTransforms = output.data(),
+					.localCount = output.size(),
+					.modelSpaceMatrices = a.lastOutput.data(),
+					.modelSpaceCount = a.lastOutput.size(),
+					.rootMatrix = a.rootMatrix,
+					.prevRootMatrix = a.prevRootMatrix,
+					.invertedRootMatrix = ozz::math::Invert(ctxt.rootMatrix, &invertible),
+					.skeleton = a_skeleton->data.get(),
+					.deltaTime = deltaTime
+				};
+				a.ikJob->Run(ctxt);
+			});
+		}
+
+		detail::TimeStage(a_timings, GraphUpdateStage::kUnpack, [&]() {
+			Util::Ozz::UnpackSoaTransforms(output, a.lastOutput, a_skeleton->data.get());
+		});
+
+		detail::TimeStage(a_timings, GraphUpdateStage::kCopyOut, [&]() {
+			const auto& source = a.lastOutput;
+			const auto& dest = a.transforms;
+			const size_t end = std::min(a.transforms.size(), source.size());
+			a.boneMask.for_each_run([&](size_t a_begin, size_t a_end) {
+				for (size_t i = a_begin; i < std::min(a_end, end); i++) {
+					*dest[i] = source[i];
+				}
+			});
+		});
+
+		a_timings[static_cast<size_t>(GraphUpdateStage::kTotal)] += std::chrono::duration<double, std::nano>(detail::Clock::now() - start).count();
+	}
+}
\ No newline at end of file
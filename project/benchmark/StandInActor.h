@@ -0,0 +1,35 @@
+#pragma once
+#include "GraphUpdateBenchmark.h"
+#include "Animation/Generator.h"
+#include "Animation/QuantizedPose.h"
+#include "Animation/Easing.h"
+#include "Animation/Jobs/IKTwoBoneJob.h"
+
+namespace Benchmark
+{
+	using StageTimings = std::array<double, GraphUpdateResult::NUM_STAGES>;
+
+	// Mirrors the parts of Graph::LOADED_DATA that take part in the pose pipeline.
+	struct StandInActor
+	{
+		Animation::PoseCache poseCache;
+		Animation::PoseCache::Handle restPose;
+		Animation::QuantizedPose snapshotPose;
+		Animation::PoseCache::Handle blendedPose;
+		std::array<ozz::animation::BlendingJob::Layer, 2> blendLayers;
+		Animation::CubicInOutEase<float> ease;
+		std::unique_ptr<Animation::LinearClipGenerator> generator;
+		std::vector<ozz::math::Float4x4> lastOutput;
+		Util::BoneMask boneMask;
+		std::vector<ozz::math::Float4x4> gameTransforms;
+		std::vector<ozz::math::Float4x4*> transforms;
+		ozz::math::Float4x4 rootMatrix;
+		ozz::math::Float4x4 prevRootMatrix;
+		std::unique_ptr<Animation::IKTwoBoneJob> ikJob;
+		float transitionTime = 0.0f;
+	};
+
+	std::unique_ptr<StandInActor> CreateStandInActor(const std::shared_ptr<const Animation::OzzSkeleton>& a_skeleton, const std::shared_ptr<Animation::OzzAnimation>& a_anim, size_t a_idx);
+	// Runs one frame of the Graph::Update pose pipeline, adding the time spent in each stage to a_timings.
+	void UpdateStandInActor(StandInActor& a_actor, const Animation::OzzSkeleton* a_skeleton, const GraphUpdateConfig& a_config, StageTimings& a_timings);
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "Synthetic.h"
+#include "Settings/SkeletonDescriptor.h"
+
+namespace Benchmark
+{
+	std::string GetBoneName(size_t a_idx)
+	{
+		return std::format("Bone_{:03}", a_idx);
+	}
+
+	std::shared_ptr<const Animation::OzzSkeleton> CreateSkeleton(size_t a_numBones)
+	{
+		Settings::SkeletonDescriptor desc;
+		desc.bones.reserve(a_numBones);
+
+		for (size_t i = 0; i < a_numBones; i++) {
+			ozz::math::Transform rest = ozz::math::Transform::identity();
+			rest.translation = { 0.0f, 0.1f, 0.0f };
+			if (i % 3 == 0) {
+				rest.rotation = ozz::math::Quaternion::FromAxisAngle({ 0.0f, 0.0f, 1.0f }, 0.1f);
+			}
+
+			// Each chain hangs off a bone from an earlier chain, which produces a shallow, wide hierarchy.
+			std::string parent;
+			if (i > 0) {
+				parent = GetBoneName(i % CHAIN_LENGTH == 1 ? (i - 1) / 2 : i - 1);
+			}
+
+			desc.AddBone(GetBoneName(i), parent, rest, -1, i % 7 != 6, i % 5 != 4);
+		}
+
+		return desc.BuildRuntime(std::format("Synthetic{}", a_numBones));
+	}
+
+	std::unique_ptr<Animation::RawOzzAnimation> CreateRawAnimation(const Animation::OzzSkeleton* a_skeleton, float a_duration, size_t a_numKeys, float a_channelDensity, size_t a_numMorphs)
+	{
+		using namespace ozz::animation::offline;
+
+		const int numJoints = a_skeleton->data->num_joints();
+		const size_t numKeys = std::max(a_numKeys, 2ui64);
+		const int numAnimated = static_cast<int>(std::ceil(static_cast<float>(numJoints) * std::clamp(a_channelDensity, 0.0f, 1.0f)));
+
+		auto result = std::make_unique<Animation::RawOzzAnimation>();
+		result->data = ozz::make_unique<RawAnimation>();
+		auto& raw = *result->data;
+		raw.duration = a_duration;
+		raw.tracks.resize(numJoints);
+
+		for (int i = 0; i < numJoints; i++) {
+			auto& track = raw.tracks[i];
+			const ozz::math::Transform& rest = ozz::animation::GetJointLocalRestPose(*a_skeleton->data, i);
+			const ozz::math::Float3 axis = (i & 1) ? ozz::math::Float3{ 0.70710678f, 0.70710678f, 0.0f } : ozz::math::Float3::y_axis();
+
+			if (i >= numAnimated) {
+				track.translations.push_back({ 0.0f, rest.translation });
+				track.rotations.push_back({ 0.0f, rest.rotation });
+				track.scales.push_back({ 0.0f, ozz::math::Float3::one() });
+				continue;
+			}
+
+			for (size_t k = 0; k < numKeys; k++) {
+				const float ratio = static_cast<float>(k) / static_cast<float>(numKeys - 1);
+				const float time = ratio * a_duration;
+				const float angle = std::sin(ratio * std::numbers::pi_v<float> * 2.0f + static_cast<float>(i)) * 0.5f;
+
+				track.translations.push_back({ time, ozz::math::Float3{ rest.translation.x, rest.translation.y + angle * 0.01f, rest.translation.z } });
+				track.rotations.push_back({ time, ozz::math::Quaternion::FromAxisAngle(axis, angle) });
+				track.scales.push_back({ time, ozz::math::Float3::one() });
+			}
+		}
+
+		if (a_numMorphs > 0) {
+			result->faceData = std::make_unique<Animation::RawOzzFaceAnimation>();
+			result->faceData->duration = a_duration;
+			for (size_t i = 0; i < result->faceData->tracks.size(); i++) {
+				auto& keys = result->faceData->tracks[i].keyframes;
+				if (i >= a_numMorphs) {
+					keys.push_back({ RawTrackInterpolation::kLinear, 0.0f, 0.0f });
+					continue;
+				}
+
+				for (size_t k = 0; k < numKeys; k++) {
+					const float ratio = static_cast<float>(k) / static_cast<float>(numKeys - 1);
+					keys.push_back({ RawTrackInterpolation::kLinear, ratio, 0.5f + std::sin(ratio * std::numbers::pi_v<float> * 2.0f + static_cast<float>(i)) * 0.5f });
+				}
+			}
+		}
+
+		return result;
+	}
+
+	std::shared_ptr<Animation::OzzAnimation> CreateAnimation(const Animation::OzzSkeleton* a_skeleton, float a_duration, size_t a_numKeys)
+	{
+		auto raw = CreateRawAnimation(a_skeleton, a_duration, a_numKeys);
+
+		ozz::animation::offline::AnimationBuilder builder;
+		auto result = std::make_shared<Animation::OzzAnimation>();
+		result->data = builder(*raw->data);
+		if (!result->data) {
+			return nullptr;
+		}
+
+		return result;
+	}
+
+	std::vector<ozz::math::Float4x4> CreateStandInTransforms(const Animation::OzzSkeleton* a_skeleton)
+	{
+		const int numJoints = a_skeleton->data->num_joints();
+		std::vector<ozz::math::Float4x4> result;
+		result.reserve(numJoints);
+
+		for (int i = 0; i < numJoints; i++) {
+			const ozz::math::Transform& rest = ozz::animation::GetJointLocalRestPose(*a_skeleton->data, i);
+			result.push_back(ozz::math::Float4x4::FromAffine(
+				ozz::math::simd_float4::Load3PtrU(&rest.translation.x),
+				ozz::math::simd_float4::LoadPtrU(&rest.rotation.x),
+				ozz::math::simd_float4::Load3PtrU(&rest.scale.x)));
+		}
+
+		return result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+#include "Animation/Ozz.h"
+
+namespace Benchmark
+{
+	// Bones of synthetic skeletons are laid out in chains of this length. Each chain starts at an index where
+	// a_idx % CHAIN_LENGTH == 1, so bones a_idx, a_idx + 1, ... up to the end of the chain form a parent-child chain.
+	inline constexpr size_t CHAIN_LENGTH = 6;
+
+	// Builds a skeleton made of short bone chains, roughly shaped like a game skeleton.
+	// Every 7th bone is excluded from the default bone mask and every 5th bone is not controlled by the game.
+	std::shared_ptr<const Animation::OzzSkeleton> CreateSkeleton(size_t a_numBones);
+
+	// Builds a looping raw animation. a_channelDensity is the fraction of joints with animated tracks (the rest hold a single
+	// rest pose key), and the first a_numMorphs face morph tracks are animated when a_numMorphs is non-zero.
+	std::unique_ptr<Animation::RawOzzAnimation> CreateRawAnimation(const Animation::OzzSkeleton* a_skeleton, float a_duration, size_t a_numKeys, float a_channelDensity = 1.0f, size_t a_numMorphs = 0);
+
+	// Builds a looping animation with a_numKeys keys per track for every joint of the skeleton.
+	std::shared_ptr<Animation::OzzAnimation> CreateAnimation(const Animation::OzzSkeleton* a_skeleton, float a_duration, size_t a_numKeys);
+
+	// Stand-in for the game's NiNode local transforms, initialized to the skeleton's rest pose.
+	std::vector<ozz::math::Float4x4> CreateStandInTransforms(const Animation::OzzSkeleton* a_skeleton);
+
+	std::string GetBoneName(size_t a_idx);
+}
\ No newline at end of file
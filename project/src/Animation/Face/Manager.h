@@ -32,7 +32,7 @@ namespace Animation::Face
 		MorphsArray current;
 	};
 
-	using MorphData = Util::Guarded<GraphStub>;
+	using MorphData = Util::Guarded<GraphStub, Util::Locks::Mutex<"Face::MorphData">>;
 
 	class Manager
 	{
@@ -52,6 +52,6 @@ namespace Animation::Face
 		std::shared_ptr<MorphData> GetMorphData(RE::BSFaceGenAnimationData* a_data);
 		void Reset();
 
-		Util::Guarded<InternalData, std::shared_mutex> data;
+		Util::Guarded<InternalData, Util::Locks::Mutex<"Face::Manager::data", std::shared_mutex>> data;
 	};
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Settings/Settings.h"
 #include "Ozz.h"
 #include "Util/Timing.h"
+#include "Util/Profiler.h"
 #include "Settings/Impl.h"
 
 namespace Animation
@@ -155,6 +156,7 @@ namespace Animation
 
 	std::shared_ptr<Procedural::PGraph> FileManager::DoLoadBlendGraph(const AnimID& a_id)
 	{
+		PROFILE_ZONE("FileManager::LoadBlendGraph");
 		auto start = Util::Timing::HighResTimeNow();
 		const std::filesystem::path localPath = a_id.file.QPath();
 		auto result = Serialization::BlendGraphImport::LoadGraph(Util::String::GetDataPath() / localPath, localPath.parent_path(), a_id.skeleton);
@@ -167,6 +169,7 @@ namespace Animation
 
 	std::shared_ptr<IBasicAnimation> FileManager::DoLoadAnimation(const AnimID& a_id)
 	{
+		PROFILE_ZONE("FileManager::LoadAnimation");
 		auto start = Util::Timing::HighResTimeNow();
 		std::shared_ptr<const OzzSkeleton> skeleton = Settings::GetSkeleton(a_id.skeleton);
 		std::shared_ptr<IBasicAnimation> result = Settings::GetImplFunctions().LoadOtherAnimationFile(a_id, skeleton.get());
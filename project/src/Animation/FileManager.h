@@ -74,8 +74,8 @@ namespace Animation
 
 	private:
 		std::jthread workerThread;
-		std::condition_variable workCV;
-		Util::Guarded<std::list<RequestData>> requests;
-		Util::Guarded<std::map<AnimID, LoadedAnimData>> loadedAnimations;
+		Util::Locks::ConditionVariable workCV;
+		Util::Guarded<std::list<RequestData>, Util::Locks::Mutex<"FileManager::requests">> requests;
+		Util::Guarded<std::map<AnimID, LoadedAnimData>, Util::Locks::Mutex<"FileManager::loadedAnimations">> loadedAnimations;
 	};
 }
\ No newline at end of file
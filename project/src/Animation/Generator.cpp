@@ -3,10 +3,13 @@
 #include "Util/Ozz.h"
 #include "Procedural/PVariableNode.h"
 #include "IBasicAnimation.h"
+#include "Replay.h"
 
 namespace Animation
 {
 	std::span<ozz::math::SoaTransform> Generator::Generate(PoseCache&, IAnimEventHandler* a_eventHandler) { return {}; }
+	bool Generator::UsesTransientPoses() { return false; }
+	void Generator::ReleaseTransientPoses() {}
 	bool Generator::HasFaceAnimation() { return false; }
 	void Generator::SetFaceMorphData(Face::MorphData* morphData){}
 	void Generator::SetContext(const ContextData& a_context) {}
@@ -159,8 +162,11 @@ namespace Animation
 
 	bool ProceduralGenerator::SetVariable(const std::string_view a_name, float a_value)
 	{
-		if (auto iter = pGraphInstance.variableMap.find(Util::String::ToLower(a_name)); iter != pGraphInstance.variableMap.end()) {
+		if (auto iter = pGraphInstance.FindVariable(Util::String::ToLower(a_name)); iter != nullptr) {
 			iter->second->value = a_value;
+			if (recorder) {
+				recorder->RecordVariable(iter->first, a_value);
+			}
 			return true;
 		} else {
 			return false;
@@ -169,25 +175,45 @@ namespace Animation
 
 	float ProceduralGenerator::GetVariable(const std::string_view a_name)
 	{
-		if (auto iter = pGraphInstance.variableMap.find(Util::String::ToLower(a_name)); iter != pGraphInstance.variableMap.end()) {
+		if (auto iter = pGraphInstance.FindVariable(Util::String::ToLower(a_name)); iter != nullptr) {
 			return iter->second->value;
 		} else {
 			return 0.0f;
 		}
 	}
 
-	void ProceduralGenerator::ForEachVariable(const std::function<void(const std::string_view, float&)>& a_func)
+	void ProceduralGenerator::ForEachVariable(const std::function<void(const std::string_view, float)>& a_func)
 	{
-		for (auto& v : pGraphInstance.variableMap) {
+		for (auto& v : pGraphInstance.variables) {
 			a_func(v.first, v.second->value);
 		}
 	}
 
+	void ProceduralGenerator::SetNodeStatsEnabled(bool a_enabled)
+	{
+		pGraph->SetNodeStatsEnabled(pGraphInstance, a_enabled);
+	}
+
+	std::vector<Procedural::PGraph::NodeCost> ProceduralGenerator::GetNodeCostReport(bool a_byType) const
+	{
+		return pGraph->GetNodeCostReport(pGraphInstance, a_byType);
+	}
+
 	std::span<ozz::math::SoaTransform> ProceduralGenerator::Generate(PoseCache& cache, IAnimEventHandler* a_eventHandler)
 	{
 		return pGraph->Evaluate(pGraphInstance, cache);
 	}
 
+	bool ProceduralGenerator::UsesTransientPoses()
+	{
+		return true;
+	}
+
+	void ProceduralGenerator::ReleaseTransientPoses()
+	{
+		pGraph->ReleasePoses(pGraphInstance);
+	}
+
 	void ProceduralGenerator::SetContext(const ContextData& a_context)
 	{
 		pGraphInstance.restPose = a_context.restPose;
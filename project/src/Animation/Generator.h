@@ -15,6 +15,7 @@ namespace Animation
 {
 	class IBasicAnimation;
 	class IBasicAnimationContext;
+	class ReplayRecorder;
 
 	enum class GenType : uint8_t
 	{
@@ -43,6 +44,10 @@ namespace Animation
 		float speed = 1.0f;
 
 		virtual std::span<ozz::math::SoaTransform> Generate(PoseCache& a_cache, IAnimEventHandler* a_eventHandler);
+		// Returns true if every pose acquired by Generate is released by ReleaseTransientPoses, so Generate can be given a scratch cache.
+		virtual bool UsesTransientPoses();
+		// Called once the output of Generate has been consumed.
+		virtual void ReleaseTransientPoses();
 		virtual bool HasFaceAnimation();
 		virtual void SetFaceMorphData(Face::MorphData* a_morphData);
 		virtual void SetContext(const ContextData& a_context);
@@ -63,13 +68,21 @@ namespace Animation
 	public:
 		std::shared_ptr<Procedural::PGraph> pGraph;
 		Procedural::PGraph::InstanceData pGraphInstance;
+		ReplayRecorder* recorder = nullptr;
 
 		ProceduralGenerator(const std::shared_ptr<Procedural::PGraph>& a_graph);
 
 		bool SetVariable(const std::string_view a_name, float a_value);
 		float GetVariable(const std::string_view a_name);
-		void ForEachVariable(const std::function<void(const std::string_view, float&)>& a_func);
+		// Values are passed by copy, so every change goes through SetVariable and reaches the replay recorder.
+		void ForEachVariable(const std::function<void(const std::string_view, float)>& a_func);
+		// Enabling (or re-enabling) node stats clears any previously gathered stats.
+		void SetNodeStatsEnabled(bool a_enabled);
+		// Nodes are ranked by combined evaluate and advance time, most expensive first.
+		std::vector<Procedural::PGraph::NodeCost> GetNodeCostReport(bool a_byType = false) const;
 		virtual std::span<ozz::math::SoaTransform> Generate(PoseCache& a_cache, IAnimEventHandler* a_eventHandler) override;
+		virtual bool UsesTransientPoses() override;
+		virtual void ReleaseTransientPoses() override;
 		virtual void SetContext(const ContextData& a_context) override;
 		virtual void AdvanceTime(float deltaTime) override;
 		virtual const std::string_view GetSourceFile() override;
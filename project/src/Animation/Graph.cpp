@@ -2,12 +2,13 @@
 #include "Util/Math.h"
 #include "Node.h"
 #include "Face/Manager.h"
-#include "Util/Timing.h"
+#include "Util/Profiler.h"
 #include "Util/String.h"
 #include "Util/Ozz.h"
 #include "Sequencer.h"
 #include "GraphManager.h"
 #include "Jobs/IKTwoBoneJob.h"
+#include "PosePool.h"
 
 namespace Animation
 {
@@ -129,7 +130,7 @@ namespace Animation
 					.modelSpaceCache = loadedData->lastOutput,
 					.prevRootTransform = reinterpret_cast<ozz::math::Float4x4*>(&loadedData->rootNode->previousWorld),
 					.rootTransform = reinterpret_cast<ozz::math::Float4x4*>(&loadedData->rootNode->world),
-					.restPose = &loadedData->restPose,
+					.restPose = &loadedData->restPose.handle(),
 					.skeleton = skeleton.get(),
 					.physSystem = loadedData->physSystem.get()
 				});
@@ -167,12 +168,12 @@ namespace Animation
 
 	void Graph::Update(float a_deltaTime, bool a_visible, GraphEventProcessor* a_gameGraph)
 	{
-		PERF_TIMER_START(start);
-
 		if (!loadedData) {
 			return;
 		}
 
+		PROFILE_ZONE_ELAPSED("Graph::Update", lastUpdateMs);
+
 		if (flags.any(FLAGS::kRequiresEyeTrackUpdate)) {
 			DisableEyeTracking();
 			flags.reset(FLAGS::kRequiresEyeTrackUpdate);
@@ -198,11 +199,17 @@ namespace Animation
 				UpdateRestPose();
 				PushAnimationOutput(a_deltaTime, loadedData->restPose.get());
 			}
-			PERF_TIMER_END(start, updateTime);
-			PERF_TIMER_COPY_VALUE(updateTime, lastUpdateMs);
 			return;
 		}
 
+		if (replayRecorder) [[unlikely]] {
+			const auto identity = ozz::math::Float4x4::identity();
+			NiSkeletonRootNode* rootNode = loadedData->rootNode;
+			replayRecorder->RecordFrame(a_deltaTime, a_visible, generator.get(),
+				rootNode ? *reinterpret_cast<ozz::math::Float4x4*>(&rootNode->world) : identity,
+				rootNode ? *reinterpret_cast<ozz::math::Float4x4*>(&rootNode->previousWorld) : identity);
+		}
+
 		generator->AdvanceTime(a_deltaTime);
 		if (sequencer) {
 			sequencer->Update();
@@ -228,28 +235,36 @@ namespace Animation
 				UpdateRestPose();
 			}
 			UpdatePreGenJobs(a_deltaTime);
-			auto generatedPose = generator->Generate(loadedData->poseCache, this);
+			PoseCache& genCache = generator->UsesTransientPoses() ? PosePool::GetScratch(skeleton->data->num_soa_joints()) : loadedData->poseCache;
+			auto generatedPose = generator->Generate(genCache, this);
 
 			if (flags.any(FLAGS::kTransitioning)) {
+				// The generated pose is blended into blendedPose and released before the transition can end, since ending
+				// it can destroy the generator along with the poses it's holding.
 				auto blendPose = loadedData->blendedPose.get();
-				AdvanceTransitionTime(a_deltaTime);
+				const bool ended = AdvanceTransitionTime(a_deltaTime);
 				UpdateTransition(ozz::make_span(blendPose), ozz::make_span(generatedPose));
+				if (generator) {
+					generator->ReleaseTransientPoses();
+				}
+				if (ended) {
+					EndTransition();
+				}
 				PushAnimationOutput(a_deltaTime, blendPose);
 			} else {
 				PushAnimationOutput(a_deltaTime, generatedPose);
+				generator->ReleaseTransientPoses();
 			}
 		} else {
-			if (flags.any(FLAGS::kTransitioning))
-				AdvanceTransitionTime(a_deltaTime);
+			if (flags.any(FLAGS::kTransitioning) && AdvanceTransitionTime(a_deltaTime)) {
+				EndTransition();
+			}
 
 			PushAnimationOutput(a_deltaTime, {});
 		}
 
 		PushRootOutput(a_visible);
 		ProcessEvents(a_gameGraph);
-
-		PERF_TIMER_END(start, updateTime);
-		PERF_TIMER_COPY_VALUE(updateTime, lastUpdateMs);
 	}
 
 	void Graph::AddPostGenJob(IPostGenJob* a_job)
@@ -452,8 +467,9 @@ namespace Animation
 			l->boneMask = skeleton->defaultBoneMask;
 			l->poseCache.set_pose_size(skeleton->data->num_soa_joints());
 			l->poseCache.reserve(4);
-			l->restPose = l->poseCache.acquire_handle();
-			l->snapshotPose = l->poseCache.acquire_handle();
+			// Lanes the game doesn't control keep the skeleton's rest pose, so only the game's lanes are packed each frame.
+			const auto skeletonRestPose = skeleton->data->joint_rest_poses();
+			l->restPose = PartialPose(l->poseCache, { skeletonRestPose.begin(), skeletonRestPose.size() }, skeleton->gameControlledLanes);
 			l->blendedPose = l->poseCache.acquire_handle();
 
 			if (unloadedData && !unloadedData->restoreFile.QPath().empty()) {
@@ -484,9 +500,7 @@ namespace Animation
 				sequencer->OnGraphUnloaded();
 			}
 
-#ifdef ENABLE_PERFORMANCE_MONITORING
 			lastUpdateMs = 0.0f;
-#endif
 		}
 	}
 
@@ -555,9 +569,48 @@ namespace Animation
 		}
 	}
 
+	bool Graph::StartReplayCapture(const std::filesystem::path& a_path)
+	{
+		StopReplayCapture();
+		replayRecorder = std::make_unique<ReplayRecorder>(a_path);
+		if (!replayRecorder->IsOpen()) {
+			replayRecorder.reset();
+			return false;
+		}
+
+		AttachReplayRecorder();
+		return true;
+	}
+
+	void Graph::StopReplayCapture()
+	{
+		if (generator && generator->GetType() == GenType::kProcedural) {
+			static_cast<ProceduralGenerator*>(generator.get())->recorder = nullptr;
+		}
+		replayRecorder.reset();
+	}
+
+	void Graph::AttachReplayRecorder()
+	{
+		if (!generator)
+			return;
+
+		replayRecorder->RecordGenerator(generator.get(), skeleton ? std::string_view{ skeleton->name } : std::string_view{});
+		if (generator->GetType() == GenType::kProcedural) {
+			auto pGen = static_cast<ProceduralGenerator*>(generator.get());
+			pGen->recorder = replayRecorder.get();
+
+			// Capture the variable values the generator already holds so playback starts from the same state.
+			pGen->ForEachVariable([&](const std::string_view a_name, float a_value) {
+				replayRecorder->RecordVariable(a_name, a_value);
+			});
+		}
+	}
+
+	// Keep in sync with GetMemoryReport.
 	size_t Graph::GetSizeBytes() const
 	{
-		size_t result = sizeof(Graph) + std::span(transforms).size_bytes() + std::span(postGenJobs).size_bytes();
+		size_t result = sizeof(Graph) + Util::Memory::GetHeapBytes(transforms) + Util::Memory::GetHeapBytes(postGenJobs);
 
 		if (sequencer)
 			result += sizeof(Sequencer);
@@ -567,15 +620,17 @@ namespace Animation
 
 		if (loadedData) {
 			auto l = loadedData.get();
-			size_t maskSize = l->boneMask.size();
-			result += sizeof(LOADED_DATA) + (l->poseCache.transforms_capacity() * sizeof(ozz::math::SoaTransform)) + std::span(l->pendingEvents).size_bytes()
-				+ std::span(l->lastOutput).size_bytes() + (maskSize > 0 ? maskSize / 8 : 0);
+			result += sizeof(LOADED_DATA) + l->poseCache.heap_bytes() + Util::Memory::GetHeapBytes(l->pendingEvents) +
+			          Util::Memory::GetHeapBytes(l->lastOutput) + l->boneMask.heap_bytes() + l->snapshotPose.heap_bytes();
 
 #ifdef TARGET_GAME_SF
 			if (l->eyeTrackData) {
 				result += sizeof(EyeTrackingData);
 			}
 #endif
+			if (l->physSystem) {
+				result += sizeof(Physics::ModelSpaceSystem);
+			}
 		}
 
 		if (unloadedData) {
@@ -585,6 +640,42 @@ namespace Animation
 		return result;
 	}
 
+	void Graph::GetMemoryReport(Util::Memory::MemoryReport& a_report) const
+	{
+		a_report.bytes += sizeof(Graph);
+		a_report.AddChild("transforms", Util::Memory::GetHeapBytes(transforms));
+		a_report.AddChild("postGenJobs", Util::Memory::GetHeapBytes(postGenJobs));
+
+		if (sequencer)
+			a_report.AddChild("sequencer", sizeof(Sequencer));
+
+		if (generator)
+			a_report.AddChild("generator", generator->GetSizeBytes());
+
+		if (loadedData) {
+			auto l = loadedData.get();
+			auto& loaded = a_report.AddChild("loadedData", sizeof(LOADED_DATA));
+			loaded.AddChild("poseCache", l->poseCache.heap_bytes());
+			loaded.AddChild("pendingEvents", Util::Memory::GetHeapBytes(l->pendingEvents));
+			loaded.AddChild("lastOutput", Util::Memory::GetHeapBytes(l->lastOutput));
+			loaded.AddChild("boneMask", l->boneMask.heap_bytes());
+			loaded.AddChild("snapshotPose", l->snapshotPose.heap_bytes());
+
+#ifdef TARGET_GAME_SF
+			if (l->eyeTrackData) {
+				loaded.AddChild("eyeTrackData", sizeof(EyeTrackingData));
+			}
+#endif
+			if (l->physSystem) {
+				loaded.AddChild("physSystem", sizeof(Physics::ModelSpaceSystem));
+			}
+		}
+
+		if (unloadedData) {
+			a_report.AddChild("unloadedData", sizeof(UNLOADED_DATA));
+		}
+	}
+
 	bool Graph::GetRequiresDetach() const
 	{
 		return flags.none(
@@ -682,24 +773,30 @@ namespace Animation
 #endif
 	}
 
-	void Graph::AdvanceTransitionTime(float a_deltaTime)
+	bool Graph::AdvanceTransitionTime(float a_deltaTime)
 	{
 		auto& transition = loadedData->transition;
 
 		transition.localTime += a_deltaTime;
-		if (transition.localTime >= transition.duration) {
-			if (transition.onEnd != nullptr) {
-				transition.onEnd();
-			}
+		if (transition.localTime < transition.duration)
+			return false;
 
-			flags.reset(FLAGS::kTransitioning);
+		if (transition.duration < 0.01f) {
+			transition.duration = 0.01f;
+		}
 
-			if (transition.duration < 0.01f) {
-				transition.duration = 0.01f;
-			}
+		transition.localTime = transition.duration;
+		return true;
+	}
 
-			transition.localTime = transition.duration;
+	void Graph::EndTransition()
+	{
+		auto& transition = loadedData->transition;
+		if (transition.onEnd != nullptr) {
+			transition.onEnd();
 		}
+
+		flags.reset(FLAGS::kTransitioning);
 	}
 
 	void Graph::UpdateTransition(const ozz::span<ozz::math::SoaTransform>& a_output, const ozz::span<ozz::math::SoaTransform>& a_generatedPose)
@@ -707,7 +804,17 @@ namespace Animation
 		auto& transition = loadedData->transition;
 		auto& blendLayers = loadedData->blendLayers;
 		blendLayers[0].transform = a_generatedPose;
-		blendLayers[1].transform = loadedData->snapshotPose.get_ozz();
+
+		// The snapshot is only a blend source when the transition starts from it.
+		PoseCache::Handle snapshotPose;
+		if (transition.startLayer == 1 && !loadedData->snapshotPose.empty()) {
+			snapshotPose = PosePool::GetScratch(skeleton->data->num_soa_joints()).acquire_handle();
+			loadedData->snapshotPose.decode(snapshotPose.get());
+			blendLayers[1].transform = snapshotPose.get_ozz();
+		} else {
+			blendLayers[1].transform = loadedData->restPose.get_ozz();
+			blendLayers[1].weight = 0.0f;
+		}
 
 		ozz::animation::BlendingJob blendJob;
 		blendJob.rest_pose = loadedData->restPose.get_ozz();
@@ -890,11 +997,15 @@ namespace Animation
 				.modelSpaceCache = loadedData->lastOutput,
 				.prevRootTransform = reinterpret_cast<ozz::math::Float4x4*>(&loadedData->rootNode->previousWorld),
 				.rootTransform = reinterpret_cast<ozz::math::Float4x4*>(&loadedData->rootNode->world),
-				.restPose = &loadedData->restPose,
+				.restPose = &loadedData->restPose.handle(),
 				.skeleton = skeleton.get(),
 				.physSystem = loadedData->physSystem.get()
 			});
 
+			if (replayRecorder) {
+				AttachReplayRecorder();
+			}
+
 			if (generator->HasFaceAnimation()) {
 				loadedData->transition.queuedDuration = a_transitionTime;
 				SetFaceMorphsControlled(true, a_transitionTime);
@@ -922,14 +1033,12 @@ namespace Animation
 		flags.set(FLAGS::kGeneratedFirstPose);
 		const auto& source = loadedData->lastOutput;
 		const auto& dest = transforms;
-		const auto& mask = loadedData->boneMask;
-
-		size_t end = transforms.size();
-		for (size_t i = 0; i < end; i++) {
-			if (mask[i]) {
+		const size_t end = std::min(transforms.size(), source.size());
+		loadedData->boneMask.for_each_run([&](size_t a_begin, size_t a_end) {
+			for (size_t i = a_begin; i < std::min(a_end, end); i++) {
 				*dest[i] = source[i];
 			}
-		}
+		});
 
 #ifdef TARGET_GAME_SF
 		auto r = loadedData->rootNode;
@@ -1034,31 +1143,14 @@ namespace Animation
 
 	void Graph::UpdateRestPose()
 	{
-		const auto output = loadedData->restPose.get();
-		const int end = skeleton->data->num_joints();
-
-		for (size_t i = 0, k = 0; i < end; i += 4, k++) {
-			ozz::math::SimdFloat4 translations[4];
-			ozz::math::SimdFloat4 rotations[4];
-			ozz::math::SimdFloat4 scales[4];
-
-			size_t remaining = std::min(4ui64, end - i);
-			for (int j = 0; j < remaining; j++) {
-				const size_t curIdx = i + j;
-				if (skeleton->controlledByGameMask[curIdx]) {
-					ozz::math::ToAffine(*transforms[i + j], &translations[j], &rotations[j], &scales[j]);
-				} else {
-					const ozz::math::Transform& rest = ozz::animation::GetJointLocalRestPose(*skeleton->data, curIdx);
-					translations[j] = ozz::math::simd_float4::Load3PtrU(&rest.translation.x);
-					rotations[j] = ozz::math::simd_float4::LoadPtrU(&rest.rotation.x);
-					scales[j] = ozz::math::simd_float4::Load3PtrU(&rest.scale.x);
-				}
-			}
+		auto& restPose = loadedData->restPose;
+		bool packed = true;
+		restPose.game_lanes().for_each_run([&](size_t a_begin, size_t a_end) {
+			packed = packed && Util::Ozz::PackRestPose(transforms, skeleton->controlledByGameMask, restPose.get(), skeleton->data.get(), a_begin, a_end);
+		});
 
-			auto& out = output[k];
-			ozz::math::Transpose4x3(translations, &out.translation.x);
-			ozz::math::Transpose4x4(rotations, &out.rotation.x);
-			ozz::math::Transpose4x3(scales, &out.scale.x);
+		if (!packed) {
+			logger::error("{:08X}: {} game transforms don't match skeleton '{}', rest pose not updated.", GetTargetFormID(), transforms.size(), skeleton->name);
 		}
 	}
 
@@ -1067,13 +1159,13 @@ namespace Animation
 		if (!loadedData)
 			return;
 
-		std::span<ozz::math::SoaTransform> snapshotPose = loadedData->snapshotPose.get();
 		if (flags.any(FLAGS::kGeneratedFirstPose)) {
-			Util::Ozz::PackSoaTransforms(loadedData->lastOutput, snapshotPose, skeleton->data.get());
+			PoseCache::Handle packedPose = PosePool::GetScratch(skeleton->data->num_soa_joints()).acquire_handle();
+			Util::Ozz::PackSoaTransforms(loadedData->lastOutput, packedPose.get(), skeleton->data.get());
+			loadedData->snapshotPose.encode(packedPose.get());
 		} else {
 			UpdateRestPose();
-			std::span<ozz::math::SoaTransform> restPose = loadedData->restPose.get();
-			std::copy(restPose.begin(), restPose.end(), snapshotPose.begin());
+			loadedData->snapshotPose.encode(loadedData->restPose.get());
 		}
 	}
 
@@ -8,7 +8,9 @@
 #include "SyncInstance.h"
 #include "Face/Manager.h"
 #include "PoseCache.h"
+#include "QuantizedPose.h"
 #include "Sequencer.h"
+#include "Replay.h"
 #include "IAnimEventHandler.h"
 #include "Jobs/IPostGenJob.h"
 #include "Physics/ModelSpaceSystem.h"
@@ -82,9 +84,10 @@ namespace Animation
 			PoseCache poseCache;
 			std::vector<std::pair<RE::BSFixedString, RE::BSFixedString>> pendingEvents;
 			std::vector<ozz::math::Float4x4> lastOutput;
-			std::vector<bool> boneMask;
-			PoseCache::Handle restPose;
-			PoseCache::Handle snapshotPose;
+			Util::BoneMask boneMask;
+			PartialPose restPose;
+			// Only read while transitioning from a snapshot, so it's kept quantized.
+			QuantizedPose snapshotPose;
 			PoseCache::Handle blendedPose;
 			std::shared_ptr<Face::MorphData> faceMorphData = nullptr;
 #ifdef TARGET_GAME_SF
@@ -100,7 +103,7 @@ namespace Animation
 			FileID restoreFile;
 		};
 
-		std::mutex lock;
+		Util::Locks::Mutex<"Graph::lock"> lock;
 		xSE::stl::enumeration<FLAGS, uint16_t> flags = kNoFlags;
 		RE::NiPointer<RE::TESObjectREFR> target;
 		std::shared_ptr<const OzzSkeleton> skeleton;
@@ -112,11 +115,10 @@ namespace Animation
 		std::unique_ptr<Generator> generator = nullptr;
 		std::unique_ptr<LOADED_DATA> loadedData = nullptr;
 		std::unique_ptr<UNLOADED_DATA> unloadedData = nullptr;
+		std::unique_ptr<ReplayRecorder> replayRecorder = nullptr;
 		RE::TESObjectCELL* lastCell = nullptr;
-#ifdef ENABLE_PERFORMANCE_MONITORING
 		float lastUpdateMs = 0.0f;
 		float baseUpdateMs = 0.0f;
-#endif
 
 		std::atomic<bool> requiresBaseTransforms = true;
 
@@ -146,7 +148,10 @@ namespace Animation
 		void DetachSequencer(bool a_transitionOut = true);
 		void SendEventInstant(const RE::BSFixedString& a_event, const RE::BSFixedString& a_arg = "");
 		void SetLockPosition(bool a_lock);
+		bool StartReplayCapture(const std::filesystem::path& a_path);
+		void StopReplayCapture();
 		size_t GetSizeBytes() const;
+		void GetMemoryReport(Util::Memory::MemoryReport& a_report) const;
 		bool GetRequiresDetach() const;
 		bool GetRequiresBaseTransforms() const;
 		uint32_t GetTargetFormID() const;
@@ -154,7 +159,10 @@ namespace Animation
 		std::string_view GetCurrentAnimationFile() const;
 
 	protected:
-		void AdvanceTransitionTime(float a_deltaTime);
+		// Returns true once the transition has reached its end. EndTransition must be called after that, once nothing
+		// reads the generator's output anymore, since the transition's onEnd can destroy the generator.
+		bool AdvanceTransitionTime(float a_deltaTime);
+		void EndTransition();
 		void UpdateTransition(const ozz::span<ozz::math::SoaTransform>& a_output, const ozz::span<ozz::math::SoaTransform>& a_generatedPose);
 		void UpdatePreGenJobs(float a_deltaTime);
 		void UpdatePostGenJobs(float a_deltaTime, const std::span<ozz::math::SoaTransform>& a_output);
@@ -166,5 +174,6 @@ namespace Animation
 		void SetFaceMorphsControlled(bool a_controlled, float a_transitionTime);
 		void SetLoaded(bool a_loaded);
 		void ProcessEvents(GraphEventProcessor* a_gameGraph) const;
+		void AttachReplayRecorder();
 	};
 }
\ No newline at end of file
@@ -5,8 +5,9 @@
 #include "Graph.h"
 #include "Generator.h"
 #include "FileManager.h"
+#include "PosePool.h"
 #include "Util/Trampoline.h"
-#include "Util/Timing.h"
+#include "Util/Profiler.h"
 
 namespace Animation
 {
@@ -22,7 +23,7 @@ namespace Animation
 				refData.localTime = gen->localTime;
 				refData.speedMult = gen->speed;
 				if (ProceduralGenerator* pGen = dynamic_cast<ProceduralGenerator*>(gen); pGen) {
-					pGen->ForEachVariable([&](std::string_view name, float& value) {
+					pGen->ForEachVariable([&](std::string_view name, float value) {
 						refData.blendVars.emplace_back(SaveData::BlendGraphVariable{ .name = std::string(name), .value = value });
 					});
 				}
@@ -392,6 +393,25 @@ namespace Animation
 		return false;
 	}
 
+	bool GraphManager::StartReplayCapture(RE::Actor* a_actor, const std::filesystem::path& a_path)
+	{
+		return VisitGraph(a_actor, [&](Graph* g) {
+			return g->StartReplayCapture(a_path);
+		});
+	}
+
+	bool GraphManager::StopReplayCapture(RE::Actor* a_actor)
+	{
+		return VisitGraph(a_actor, [&](Graph* g) {
+			if (!g->replayRecorder)
+				return false;
+
+			logger::info("Stopped replay capture after {} frames.", g->replayRecorder->GetFrameCount());
+			g->StopReplayCapture();
+			return true;
+		});
+	}
+
 	void GraphManager::GetAllGraphs(std::vector<std::pair<RE::TESObjectREFR*, std::weak_ptr<Graph>>>& a_refsOut)
 	{
 		std::shared_lock ls{ stateLock };
@@ -404,6 +424,45 @@ namespace Animation
 		}
 	}
 
+	Util::Memory::MemoryReport GraphManager::CreateMemoryReport()
+	{
+		Util::Memory::MemoryReport result;
+		result.name = "NAF";
+
+		auto& graphs = result.AddChild("graphs");
+		std::vector<std::pair<RE::TESObjectREFR*, std::weak_ptr<Graph>>> allGraphs;
+		GetAllGraphs(allGraphs);
+		for (auto& [ref, weakGraph] : allGraphs) {
+			auto g = weakGraph.lock();
+			if (!g)
+				continue;
+
+			std::unique_lock l{ g->lock };
+			auto& entry = graphs.AddChild(std::format("{:08X}", g->GetTargetFormID()));
+			g->GetMemoryReport(entry);
+		}
+
+		auto& files = result.AddChild("files");
+		std::vector<std::pair<AnimID, std::weak_ptr<IAnimationFile>>> allFiles;
+		FileManager::GetSingleton()->GetAllLoadedAnimations(allFiles);
+		for (auto& [id, weakFile] : allFiles) {
+			auto f = weakFile.lock();
+			if (!f)
+				continue;
+
+			files.AddChild(std::format("{} ({})", id.file.QPath(), id.skeleton), f->GetSizeBytes());
+		}
+
+		Settings::GetSkeletonMemoryReport(result.AddChild("skeletons"));
+		result.AddChild("posePool", PosePool::GetSingleton()->GetFreeBytes());
+		return result;
+	}
+
+	bool GraphManager::WriteMemoryReport(const std::filesystem::path& a_path)
+	{
+		return Util::Memory::WriteJson(a_path, CreateMemoryReport());
+	}
+
 	GraphManager& gm = *GraphManager::GetSingleton();
 
 #ifdef TARGET_GAME_SF
@@ -416,12 +475,14 @@ namespace Animation
 
 				bool modelCulled = a_updateData->modelCulled;
 				a_updateData->modelCulled = modelCulled || !g->GetRequiresBaseTransforms();
-				PERF_TIMER_START(start);
-				GraphUpdateHook(a_graphHolder, a_updateData, a_graph);
-				PERF_TIMER_END(start, baseUpdateTime);
+				float baseUpdateTime = 0.0f;
+				{
+					PROFILE_ZONE_ELAPSED("GraphManager::BaseUpdate", baseUpdateTime);
+					GraphUpdateHook(a_graphHolder, a_updateData, a_graph);
+				}
 
 				std::unique_lock gl{ g->lock };
-				PERF_TIMER_COPY_VALUE(baseUpdateTime, g->baseUpdateMs);
+				g->baseUpdateMs = baseUpdateTime;
 				g->Update(a_updateData->timeDelta, !modelCulled, nullptr);
 
 				if (g->GetRequiresDetach()) {
@@ -471,12 +532,14 @@ namespace Animation
 				bool visible = a_updateData->visible;
 				a_updateData->visible = visible && g->GetRequiresBaseTransforms();
 
-				PERF_TIMER_START(start);
-				GraphUpdateHook(a_graphManager, a_updateData);
-				PERF_TIMER_END(start, baseTime);
+				float baseTime = 0.0f;
+				{
+					PROFILE_ZONE_ELAPSED("GraphManager::BaseUpdate", baseTime);
+					GraphUpdateHook(a_graphManager, a_updateData);
+				}
 
 				std::unique_lock gl{ g->lock };
-				PERF_TIMER_COPY_VALUE(baseTime, g->baseUpdateMs);
+				g->baseUpdateMs = baseTime;
 				g->Update(a_updateData->timeDelta, visible, bsGraph.get());
 
 				if (g->GetRequiresDetach()) {
@@ -3,6 +3,7 @@
 #include "Graph.h"
 #include "Sequencer.h"
 #include "Util/Event.h"
+#include "Util/Memory.h"
 
 namespace Animation
 {
@@ -41,7 +42,7 @@ namespace Animation
 			std::vector<RefData> refs;
 		};
 
-		std::shared_mutex stateLock;
+		Util::Locks::Mutex<"GraphManager::stateLock", std::shared_mutex> stateLock;
 		std::unique_ptr<PersistentState> state = std::make_unique<PersistentState>();
 		std::atomic<bool> playerIsManaged = false;
 
@@ -64,6 +65,8 @@ namespace Animation
 		bool AttachGenerator(RE::Actor* a_actor, std::unique_ptr<Generator> a_gen, float a_transitionTime);
 		bool DetachGenerator(RE::Actor* a_actor, float a_transitionTime);
 		bool DetachGraph(RE::TESObjectREFR* a_graphHolder);
+		bool StartReplayCapture(RE::Actor* a_actor, const std::filesystem::path& a_path);
+		bool StopReplayCapture(RE::Actor* a_actor);
 
 		template <typename F>
 		inline bool VisitGraph(RE::Actor* a_actor, F a_visitFunc, bool a_create = false)
@@ -81,6 +84,9 @@ namespace Animation
 		}
 		
 		void GetAllGraphs(std::vector<std::pair<RE::TESObjectREFR*, std::weak_ptr<Graph>>>& a_refsOut);
+		// Breaks resident memory down per graph, loaded file and skeleton.
+		Util::Memory::MemoryReport CreateMemoryReport();
+		bool WriteMemoryReport(const std::filesystem::path& a_path);
 		void Reset();
 		std::shared_ptr<Graph> GetGraph(RE::Actor* a_actor, bool a_create);
 		void SetGraphLoaded(RE::IAnimationGraphManagerHolder* a_graph, bool a_loaded);
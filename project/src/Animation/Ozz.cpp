@@ -82,3 +82,22 @@ std::unique_ptr<Animation::IBasicAnimationContext> Animation::OzzAnimation::Crea
 		return nullptr;
 	}
 }
+
+
+size_t Animation::OzzSkeleton::GetSizeBytes() const
+{
+	size_t result = sizeof(OzzSkeleton) + defaultBoneMask.heap_bytes() + controlledByGameMask.heap_bytes() + gameControlledLanes.heap_bytes() + name.capacity();
+#ifdef TARGET_GAME_F4
+	result += Util::Memory::GetHeapBytes(havokRestPose) + Util::Memory::GetHeapBytes(havokToOzzIdxs);
+#endif
+
+	if (data) {
+		// ozz::animation::Skeleton keeps its rest poses, parents and names in a single allocation.
+		result += sizeof(ozz::animation::Skeleton) + data->joint_rest_poses().size_bytes() + data->joint_parents().size_bytes() + data->joint_names().size_bytes();
+		for (const char* n : data->joint_names()) {
+			result += std::strlen(n) + 1;
+		}
+	}
+
+	return result;
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "FileID.h"
 #include "IBasicAnimation.h"
+#include "PartialPose.h"
 
 namespace Animation
 {
@@ -48,12 +49,16 @@ namespace Animation
 	struct OzzSkeleton : public std::enable_shared_from_this<OzzSkeleton>
 	{
 		ozz::unique_ptr<ozz::animation::Skeleton> data = nullptr;
-		std::vector<bool> defaultBoneMask;
-		std::vector<bool> controlledByGameMask;
+		Util::BoneMask defaultBoneMask;
+		Util::BoneMask controlledByGameMask;
+		// SoA lanes with at least one joint controlled by the game. All other lanes of a rest pose never change.
+		SoaLaneMask gameControlledLanes;
 		std::string name;
 #ifdef TARGET_GAME_F4
 		std::vector<RE::hkQsTransformf> havokRestPose;
 		std::vector<int32_t> havokToOzzIdxs;
 #endif
+
+		size_t GetSizeBytes() const;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "PartialPose.h"
+
+namespace Animation
+{
+	SoaLaneMask::SoaLaneMask(size_t a_numLanes)
+	{
+		resize(a_numLanes);
+	}
+
+	SoaLaneMask SoaLaneMask::FromJointMask(const Util::BoneMask& a_jointMask, bool a_value)
+	{
+		SoaLaneMask result((a_jointMask.size() + 3) / 4);
+		for (size_t i = 0; i < result.size(); i++) {
+			const uint8_t bits = a_jointMask.lane_bits(i);
+			if ((a_value ? bits : (~bits & a_jointMask.lane_full_bits(i))) != 0) {
+				result.set(i);
+			}
+		}
+		return result;
+	}
+
+	void SoaLaneMask::resize(size_t a_numLanes)
+	{
+		_numLanes = a_numLanes;
+		_words.resize((a_numLanes + 63) / 64, 0);
+	}
+
+	void SoaLaneMask::set(size_t a_lane)
+	{
+		_words[a_lane / 64] |= 1ui64 << (a_lane % 64);
+	}
+
+	void SoaLaneMask::set_all()
+	{
+		std::fill(_words.begin(), _words.end(), UINT64_MAX);
+		if (const size_t tail = _numLanes % 64; tail != 0) {
+			_words.back() = (1ui64 << tail) - 1;
+		}
+	}
+
+	void SoaLaneMask::clear()
+	{
+		std::fill(_words.begin(), _words.end(), 0);
+	}
+
+	bool SoaLaneMask::test(size_t a_lane) const
+	{
+		return (_words[a_lane / 64] >> (a_lane % 64)) & 1;
+	}
+
+	bool SoaLaneMask::any() const
+	{
+		return std::any_of(_words.begin(), _words.end(), [](uint64_t w) { return w != 0; });
+	}
+
+	size_t SoaLaneMask::count() const
+	{
+		size_t result = 0;
+		for (auto w : _words) {
+			result += std::popcount(w);
+		}
+		return result;
+	}
+
+	size_t SoaLaneMask::size() const
+	{
+		return _numLanes;
+	}
+
+	size_t SoaLaneMask::heap_bytes() const
+	{
+		return Util::Memory::GetHeapBytes(_words);
+	}
+
+	PartialPose::PartialPose(PoseCache& a_cache, std::span<const ozz::math::SoaTransform> a_base, const SoaLaneMask& a_gameLanes) :
+		_pose(a_cache.acquire_handle()),
+		_gameLanes(a_gameLanes)
+	{
+		auto pose = _pose.get();
+		std::copy_n(a_base.begin(), std::min(a_base.size(), pose.size()), pose.begin());
+	}
+
+	std::span<ozz::math::SoaTransform> PartialPose::get()
+	{
+		return _pose.get();
+	}
+
+	ozz::span<ozz::math::SoaTransform> PartialPose::get_ozz()
+	{
+		return _pose.get_ozz();
+	}
+
+	PoseCache::Handle& PartialPose::handle()
+	{
+		return _pose;
+	}
+
+	const SoaLaneMask& PartialPose::game_lanes() const
+	{
+		return _gameLanes;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+#include "PoseCache.h"
+#include "Util/BoneMask.h"
+
+namespace Animation
+{
+	// One bit per SoA lane of a pose, where a lane is a single SoaTransform holding 4 joints.
+	class SoaLaneMask
+	{
+	public:
+		SoaLaneMask() = default;
+		SoaLaneMask(size_t a_numLanes);
+
+		// Marks every lane that contains at least one joint with a_value in a_jointMask.
+		static SoaLaneMask FromJointMask(const Util::BoneMask& a_jointMask, bool a_value = true);
+
+		void resize(size_t a_numLanes);
+		void set(size_t a_lane);
+		void set_all();
+		void clear();
+		bool test(size_t a_lane) const;
+		bool any() const;
+		size_t count() const;
+		size_t size() const;
+		size_t heap_bytes() const;
+
+		// Calls a_func(begin, end) for every run of consecutive set lanes.
+		template <typename F>
+		void for_each_run(F&& a_func) const
+		{
+			size_t i = 0;
+			while (i < _numLanes) {
+				if (!test(i)) {
+					i++;
+					continue;
+				}
+
+				const size_t begin = i;
+				while (i < _numLanes && test(i)) {
+					i++;
+				}
+				a_func(begin, i);
+			}
+		}
+
+	private:
+		std::vector<uint64_t> _words;
+		size_t _numLanes = 0;
+	};
+
+	// A pose that's filled from a base pose once, after which only its game-controlled lanes are rewritten. Lanes outside
+	// that mask keep the base pose, so updating it costs O(game-controlled lanes) instead of O(num_soa_joints).
+	class PartialPose
+	{
+	public:
+		PartialPose() = default;
+		PartialPose(PoseCache& a_cache, std::span<const ozz::math::SoaTransform> a_base, const SoaLaneMask& a_gameLanes);
+
+		std::span<ozz::math::SoaTransform> get();
+		ozz::span<ozz::math::SoaTransform> get_ozz();
+		PoseCache::Handle& handle();
+		const SoaLaneMask& game_lanes() const;
+
+	private:
+		PoseCache::Handle _pose;
+		SoaLaneMask _gameLanes;
+	};
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "PoseCache.h"
+#include "PosePool.h"
 
 namespace Animation
 {
@@ -7,10 +8,11 @@ namespace Animation
 		operator=(std::forward<Handle&&>(a_rhs));
 	}
 
-	PoseCache::Handle::Handle(PoseCache* a_owner, size_t a_idx)
+	PoseCache::Handle::Handle(PoseCache* a_owner, size_t a_idx, bool a_borrowed)
 	{
 		_owner = a_owner;
 		_impl = a_idx;
+		_borrowed = a_borrowed;
 	}
 
 	PoseCache::Handle::~Handle()
@@ -23,8 +25,10 @@ namespace Animation
 		reset();
 		_impl = a_rhs._impl;
 		_owner = a_rhs._owner;
+		_borrowed = a_rhs._borrowed;
 		a_rhs._impl = UINT64_MAX;
 		a_rhs._owner = nullptr;
+		a_rhs._borrowed = false;
 	}
 
 	std::span<ozz::math::SoaTransform> PoseCache::Handle::get()
@@ -48,9 +52,12 @@ namespace Animation
 	void PoseCache::Handle::reset()
 	{
 		if (_owner != nullptr && _impl != UINT64_MAX) {
-			_owner->release_handle(_impl);
+			if (!_borrowed) {
+				_owner->release_handle(_impl);
+			}
 			_impl = UINT64_MAX;
 			_owner = nullptr;
+			_borrowed = false;
 		}
 	}
 
@@ -59,6 +66,19 @@ namespace Animation
 		return _owner != nullptr && _impl != UINT64_MAX;
 	}
 
+	PoseCache::Handle PoseCache::Handle::borrow() const
+	{
+		return Handle{ _owner, _impl, true };
+	}
+
+	PoseCache::~PoseCache()
+	{
+		auto pool = PosePool::GetSingleton();
+		for (auto& c : _chunks) {
+			pool->ReleaseChunk(_pose_size, std::move(c));
+		}
+	}
+
 	void PoseCache::set_pose_size(size_t a_size)
 	{
 		_pose_size = a_size;
@@ -66,31 +86,63 @@ namespace Animation
 
 	void PoseCache::reserve(size_t a_numPoses)
 	{
-		_cache.reserve(a_numPoses * _pose_size);
+		while (_chunks.size() * POSES_PER_CHUNK < a_numPoses) {
+			add_chunk();
+		}
 	}
 
 	PoseCache::Handle PoseCache::acquire_handle()
 	{
+		_acquired_count++;
 		if (!_freeIdxs.empty()) {
 			size_t targetIdx = _freeIdxs.back();
 			_freeIdxs.pop_back();
 
 			return Handle{ this, targetIdx };
 		} else {
-			size_t start = _cache.size();
-			size_t newSize = start + _pose_size;
-			if (newSize > _cache.capacity()) {
-				_cache.reserve(newSize);
+			if (_slot_count == _chunks.size() * POSES_PER_CHUNK) {
+				add_chunk();
 			}
-			_cache.resize(newSize);
-			
-			return Handle{ this, start };
+
+			return Handle{ this, _slot_count++ };
 		}
 	}
 
+	size_t PoseCache::pose_size() const
+	{
+		return _pose_size;
+	}
+
 	size_t PoseCache::transforms_capacity() const
 	{
-		return _cache.capacity();
+		return _chunks.size() * POSES_PER_CHUNK * _pose_size;
+	}
+
+	size_t PoseCache::acquired_count() const
+	{
+		return _acquired_count;
+	}
+
+	size_t PoseCache::handle_count() const
+	{
+		return _slot_count;
+	}
+
+	size_t PoseCache::heap_bytes() const
+	{
+		size_t result = Util::Memory::GetHeapBytes(_freeIdxs) + Util::Memory::GetHeapBytes(_chunks);
+		for (auto& c : _chunks) {
+			result += Util::Memory::GetHeapBytes(c);
+		}
+		return result;
+	}
+
+	void PoseCache::add_chunk()
+	{
+		// The chunk list itself may reallocate, but moving a vector keeps its buffer, so existing spans are unaffected.
+		_chunks.push_back(PosePool::GetSingleton()->AcquireChunk(_pose_size));
+		// Keeps release_handle from ever allocating.
+		_freeIdxs.reserve(_chunks.size() * POSES_PER_CHUNK);
 	}
 
 	void PoseCache::release_handle(size_t a_idx)
@@ -100,11 +152,11 @@ namespace Animation
 
 	std::span<ozz::math::SoaTransform> PoseCache::get_span(size_t a_idx)
 	{
-		return { &_cache[a_idx], _pose_size };
+		return { &_chunks[a_idx / POSES_PER_CHUNK][(a_idx % POSES_PER_CHUNK) * _pose_size], _pose_size };
 	}
 
 	ozz::span<ozz::math::SoaTransform> PoseCache::get_span_ozz(size_t a_idx)
 	{
-		return { &_cache[a_idx], _pose_size };
+		return { &_chunks[a_idx / POSES_PER_CHUNK][(a_idx % POSES_PER_CHUNK) * _pose_size], _pose_size };
 	}
 }
\ No newline at end of file
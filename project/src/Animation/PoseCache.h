@@ -1,4 +1,5 @@
 #pragma once
+#include "Util/Memory.h"
 
 namespace Animation
 {
@@ -22,22 +23,42 @@ namespace Animation
 			ozz::span<ozz::math::SoaTransform> get_ozz();
 			void reset();
 			bool is_valid() const;
+			// Returns a handle to the same pose that doesn't release it. It must not outlive this handle.
+			Handle borrow() const;
 
 		protected:
 			friend class PoseCache;
-			Handle(PoseCache* a_owner, size_t a_idx);
+			Handle(PoseCache* a_owner, size_t a_idx, bool a_borrowed = false);
 
 		private:
 			PoseCache* _owner{ nullptr };
 			size_t _impl = UINT64_MAX;
+			bool _borrowed = false;
 		};
 
+		using Chunk = Util::Memory::CountedVector<ozz::math::SoaTransform, Util::Memory::Tag::kPoseCache>;
+
+		// Poses are stored in fixed-size chunks that are never moved or reallocated, so spans stay valid for the lifetime of their handle.
+		// Chunks come from and are returned to the PosePool.
+		inline static constexpr size_t POSES_PER_CHUNK{ 4 };
+
+		PoseCache() = default;
+		PoseCache(const PoseCache&) = delete;
+		PoseCache& operator=(const PoseCache&) = delete;
+		~PoseCache();
+
+		// Must be called before any handles are acquired.
 		void set_pose_size(size_t a_size);
 		void reserve(size_t a_numPoses);
 
-		// This function may invalidate existing spans if the cache has no free handles and needs to grow to accomodate the new handle.
 		Handle acquire_handle();
+		size_t pose_size() const;
 		size_t transforms_capacity() const;
+		// Total number of handles acquired over the lifetime of the cache.
+		size_t acquired_count() const;
+		// Number of pose slots in the cache, which is the peak number of handles that were alive at the same time.
+		size_t handle_count() const;
+		size_t heap_bytes() const;
 		
 	protected:
 		friend class Handle;
@@ -46,8 +67,13 @@ namespace Animation
 		ozz::span<ozz::math::SoaTransform> get_span_ozz(size_t a_idx);
 
 	private:
-		size_t _pose_size;
+		void add_chunk();
+
+		size_t _pose_size = 0;
+		size_t _acquired_count = 0;
+		// Number of slots that have been handed out at least once. Slots past this are unused chunk space.
+		size_t _slot_count = 0;
 		std::vector<size_t> _freeIdxs;
-		std::vector<ozz::math::SoaTransform> _cache;
+		std::vector<Chunk> _chunks;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "PosePool.h"
+
+namespace Animation
+{
+	namespace detail
+	{
+		std::unordered_map<size_t, PoseCache>& GetThreadScratch()
+		{
+			thread_local std::unordered_map<size_t, PoseCache> scratch;
+			return scratch;
+		}
+	}
+
+	PosePool* PosePool::GetSingleton()
+	{
+		// Never destroyed, as scratch caches return their chunks to the pool during thread exit.
+		static PosePool* singleton{ new PosePool() };
+		return singleton;
+	}
+
+	PoseCache& PosePool::GetScratch(size_t a_poseSize)
+	{
+		auto [iter, inserted] = detail::GetThreadScratch().try_emplace(a_poseSize);
+		if (inserted) {
+			iter->second.set_pose_size(a_poseSize);
+		}
+		return iter->second;
+	}
+
+	void PosePool::ReleaseScratch()
+	{
+		detail::GetThreadScratch().clear();
+	}
+
+	PoseCache::Chunk PosePool::AcquireChunk(size_t a_poseSize)
+	{
+		{
+			std::unique_lock l{ lock };
+			if (auto bucket = FindBucket(a_poseSize); bucket && !bucket->empty()) {
+				PoseCache::Chunk result = std::move(bucket->back());
+				bucket->pop_back();
+				return result;
+			}
+		}
+
+		return PoseCache::Chunk(PoseCache::POSES_PER_CHUNK * a_poseSize);
+	}
+
+	void PosePool::ReleaseChunk(size_t a_poseSize, PoseCache::Chunk&& a_chunk)
+	{
+		std::unique_lock l{ lock };
+		auto bucket = FindBucket(a_poseSize);
+		if (!bucket) {
+			bucket = &buckets.emplace_back(a_poseSize, std::vector<PoseCache::Chunk>{}).second;
+		}
+		if (bucket->size() < MAX_FREE_CHUNKS_PER_BUCKET) {
+			bucket->push_back(std::move(a_chunk));
+		}
+	}
+
+	size_t PosePool::GetFreeBytes()
+	{
+		std::unique_lock l{ lock };
+		size_t result = Util::Memory::GetHeapBytes(buckets);
+		for (auto& [size, bucket] : buckets) {
+			result += Util::Memory::GetHeapBytes(bucket);
+			for (auto& c : bucket) {
+				result += Util::Memory::GetHeapBytes(c);
+			}
+		}
+		return result;
+	}
+
+	void PosePool::Trim()
+	{
+		std::unique_lock l{ lock };
+		buckets.clear();
+	}
+
+	std::vector<PoseCache::Chunk>* PosePool::FindBucket(size_t a_poseSize)
+	{
+		for (auto& [size, bucket] : buckets) {
+			if (size == a_poseSize) {
+				return &bucket;
+			}
+		}
+		return nullptr;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+#include "PoseCache.h"
+#include "Util/General.h"
+
+namespace Animation
+{
+	// Shares pose chunks between every PoseCache with the same pose size, so chunks freed by one graph can be picked up
+	// by another instead of each graph keeping its own peak allocation around.
+	class PosePool
+	{
+	public:
+		// Free chunks above this count are returned to the heap instead of the pool.
+		inline static constexpr size_t MAX_FREE_CHUNKS_PER_BUCKET{ 64 };
+
+		static PosePool* GetSingleton();
+
+		// Returns the calling thread's scratch cache for poses of a_poseSize. Graphs can be updated from a different thread
+		// each frame, so every handle acquired from a scratch cache must be released before the update that acquired it returns.
+		static PoseCache& GetScratch(size_t a_poseSize);
+		// Destroys the calling thread's scratch caches, returning their chunks to the pool. No handles acquired from them
+		// may still be alive.
+		static void ReleaseScratch();
+
+		PoseCache::Chunk AcquireChunk(size_t a_poseSize);
+		void ReleaseChunk(size_t a_poseSize, PoseCache::Chunk&& a_chunk);
+		size_t GetFreeBytes();
+		void Trim();
+
+	private:
+		Util::Locks::Mutex<"PosePool::lock"> lock;
+		// Free chunks by pose size. There are only ever a few pose sizes, so a flat list keeps GetFreeBytes down to plain vector capacities.
+		std::vector<std::pair<size_t, std::vector<PoseCache::Chunk>>> buckets;
+
+		std::vector<PoseCache::Chunk>* FindBucket(size_t a_poseSize);
+	};
+}
\ No newline at end of file
@@ -6,7 +6,7 @@ namespace Animation::Procedural
 	class PActorNode : public PNodeT<PActorNode>
 	{
 	public:
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override;
+		uint64_t Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext);
 
 		inline static Registration _reg{
 			"actor",
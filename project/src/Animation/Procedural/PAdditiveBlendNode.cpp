@@ -2,12 +2,20 @@
 
 namespace Animation::Procedural
 {
-	PEvaluationResult PAdditiveBlendNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	PoseCache::Handle PAdditiveBlendNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
-		auto& addInput = std::get<PoseCache::Handle>(a_evalContext.results[inputs[0]]);
-		auto& fullInput = std::get<PoseCache::Handle>(a_evalContext.results[inputs[1]]);
-		auto& valueInput = std::get<float>(a_evalContext.results[inputs[2]]);
-		auto output = a_poseCache.acquire_handle();
+		auto& fullInput = GetRequiredInput<PoseCache::Handle>(1, a_evalContext);
+		auto& valueInput = GetRequiredInput<float>(2, a_evalContext);
+		auto output = AcquireOutputPose(a_poseCache, a_evalContext);
+
+		// A weight of 0 leaves the full pose unchanged, and the additive pose may not have been evaluated.
+		if (valueInput == 0.0f) {
+			auto inputSpan = fullInput.get();
+			std::copy(inputSpan.begin(), inputSpan.end(), output.get().begin());
+			return output;
+		}
+
+		auto& addInput = GetRequiredInput<PoseCache::Handle>(0, a_evalContext);
 
 		std::array<ozz::animation::BlendingJob::Layer, 1> blendLayers;
 		blendLayers[0].weight = valueInput;
@@ -23,4 +31,14 @@ namespace Animation::Procedural
 
 		return output;
 	}
+
+	uint32_t PAdditiveBlendNode::GetConditionalInputs()
+	{
+		return 0b001;
+	}
+
+	uint32_t PAdditiveBlendNode::GetSkippedInputs(PEvaluationContext& a_evalContext)
+	{
+		return GetRequiredInput<float>(2, a_evalContext) == 0.0f ? 0b001 : 0;
+	}
 }
\ No newline at end of file
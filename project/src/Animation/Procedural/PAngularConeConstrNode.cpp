@@ -10,12 +10,12 @@ namespace Animation::Procedural
 		return this;
 	}
 
-	std::unique_ptr<PNodeInstanceData> PAngularConeConstrNode::CreateInstanceData()
+	PNodeInstanceData* PAngularConeConstrNode::CreateInstanceData(void* a_memory)
 	{
-		return std::make_unique<InstanceData>();
+		return new (a_memory) InstanceData();
 	}
 
-	PEvaluationResult PAngularConeConstrNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	PDataObject* PAngularConeConstrNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
 		auto inst = static_cast<InstanceData*>(a_instanceData);
 		const float halfAngle = GetRequiredInput<float>(0, a_evalContext) * Util::DEGREE_TO_RADIAN;
@@ -6,7 +6,7 @@ namespace Animation::Procedural
 	class PBasePoseNode : public PNodeT<PBasePoseNode>
 	{
 	public:
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override;
+		PoseCache::Handle Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext);
 
 		inline static Registration _reg{
 			"base_pose",
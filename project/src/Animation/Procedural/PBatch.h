@@ -0,0 +1,82 @@
+#pragma once
+#include "PNode.h"
+
+namespace Animation::Procedural
+{
+	// Batch kernels process the instances of a batch four at a time, one instance per SIMD lane. The last group of a
+	// batch is padded by repeating its last instance, which is harmless since every lane of a group is gathered before
+	// any lane is written back.
+	using PBatchGroup = std::array<PEvaluationContext*, 4>;
+
+	template <typename T>
+	using PBatchInstances = std::array<T*, 4>;
+
+	template <typename F>
+	inline void ForEachBatchGroup(std::span<PEvaluationContext* const> a_evalContexts, F&& a_func)
+	{
+		const size_t last = a_evalContexts.size() - 1;
+		for (size_t i = 0; i < a_evalContexts.size(); i += 4) {
+			a_func(PBatchGroup{
+				a_evalContexts[i],
+				a_evalContexts[std::min(i + 1, last)],
+				a_evalContexts[std::min(i + 2, last)],
+				a_evalContexts[std::min(i + 3, last)] });
+		}
+	}
+
+	template <typename T>
+	inline PBatchInstances<T> GetBatchInstances(const PBatchGroup& a_group, uint32_t a_nodeIdx)
+	{
+		return {
+			static_cast<T*>(a_group[0]->nodeInstances[a_nodeIdx]),
+			static_cast<T*>(a_group[1]->nodeInstances[a_nodeIdx]),
+			static_cast<T*>(a_group[2]->nodeInstances[a_nodeIdx]),
+			static_cast<T*>(a_group[3]->nodeInstances[a_nodeIdx])
+		};
+	}
+
+	inline ozz::math::SimdFloat4 GatherFloats(const PBatchGroup& a_group, uint32_t a_slot)
+	{
+		return ozz::math::simd_float4::Load(
+			a_group[0]->results.floats[a_slot],
+			a_group[1]->results.floats[a_slot],
+			a_group[2]->results.floats[a_slot],
+			a_group[3]->results.floats[a_slot]);
+	}
+
+	template <typename T>
+	inline ozz::math::SimdFloat4 GatherFloats(const PBatchInstances<T>& a_insts, float T::*a_member)
+	{
+		return ozz::math::simd_float4::Load(a_insts[0]->*a_member, a_insts[1]->*a_member, a_insts[2]->*a_member, a_insts[3]->*a_member);
+	}
+
+	// Returns a lane mask that's set for each instance where a_pred is true.
+	template <typename T, typename P>
+	inline ozz::math::SimdInt4 GatherMask(const PBatchInstances<T>& a_insts, P&& a_pred)
+	{
+		return ozz::math::simd_int4::Load(
+			a_pred(a_insts[0]) ? -1 : 0,
+			a_pred(a_insts[1]) ? -1 : 0,
+			a_pred(a_insts[2]) ? -1 : 0,
+			a_pred(a_insts[3]) ? -1 : 0);
+	}
+
+	inline void ScatterFloats(const PBatchGroup& a_group, uint32_t a_slot, ozz::math::_SimdFloat4 a_values)
+	{
+		alignas(16) float values[4];
+		ozz::math::StorePtr(a_values, values);
+		for (size_t i = 0; i < 4; i++) {
+			a_group[i]->results.floats[a_slot] = values[i];
+		}
+	}
+
+	template <typename T>
+	inline void ScatterFloats(const PBatchInstances<T>& a_insts, float T::*a_member, ozz::math::_SimdFloat4 a_values)
+	{
+		alignas(16) float values[4];
+		ozz::math::StorePtr(a_values, values);
+		for (size_t i = 0; i < 4; i++) {
+			a_insts[i]->*a_member = values[i];
+		}
+	}
+}
\ No newline at end of file
@@ -2,12 +2,20 @@
 
 namespace Animation::Procedural
 {
-	PEvaluationResult PBlend1DNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	PoseCache::Handle PBlend1DNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
-		auto& pose1Input = std::get<PoseCache::Handle>(a_evalContext.results[inputs[0]]);
-		auto& pose2Input = std::get<PoseCache::Handle>(a_evalContext.results[inputs[1]]);
-		auto& valueInput = std::get<float>(a_evalContext.results[inputs[2]]);
-		auto output = a_poseCache.acquire_handle();
+		auto& valueInput = GetRequiredInput<float>(2, a_evalContext);
+		auto output = AcquireOutputPose(a_poseCache, a_evalContext);
+
+		// At either end of the range only one pose contributes, and the other one may not have been evaluated.
+		if (valueInput >= 1.0f || valueInput <= 0.0f) {
+			auto inputSpan = GetRequiredInput<PoseCache::Handle>(valueInput >= 1.0f ? 0 : 1, a_evalContext).get();
+			std::copy(inputSpan.begin(), inputSpan.end(), output.get().begin());
+			return output;
+		}
+
+		auto& pose1Input = GetRequiredInput<PoseCache::Handle>(0, a_evalContext);
+		auto& pose2Input = GetRequiredInput<PoseCache::Handle>(1, a_evalContext);
 
 		std::array<ozz::animation::BlendingJob::Layer, 2> blendLayers;
 		blendLayers[0].weight = valueInput;
@@ -25,4 +33,21 @@ namespace Animation::Procedural
 
 		return output;
 	}
+
+	uint32_t PBlend1DNode::GetConditionalInputs()
+	{
+		return 0b011;
+	}
+
+	uint32_t PBlend1DNode::GetSkippedInputs(PEvaluationContext& a_evalContext)
+	{
+		const float value = GetRequiredInput<float>(2, a_evalContext);
+		if (value >= 1.0f) {
+			return 0b010;
+		} else if (value <= 0.0f) {
+			return 0b001;
+		} else {
+			return 0;
+		}
+	}
 }
\ No newline at end of file
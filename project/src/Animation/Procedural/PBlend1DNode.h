@@ -6,7 +6,9 @@ namespace Animation::Procedural
 	class PBlend1DNode : public PNodeT<PBlend1DNode>
 	{
 	public:
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override;
+		PoseCache::Handle Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext);
+		virtual uint32_t GetConditionalInputs() override;
+		virtual uint32_t GetSkippedInputs(PEvaluationContext& a_evalContext) override;
 
 		inline static Registration _reg{
 			"blend_1d",
@@ -27,19 +27,19 @@ namespace Animation::Procedural
 		}
 	}
 
-	std::unique_ptr<PNodeInstanceData> PBlend2DNode::CreateInstanceData()
+	PNodeInstanceData* PBlend2DNode::CreateInstanceData(void* a_memory)
 	{
-		std::unique_ptr<InstanceData> result = std::make_unique<InstanceData>();
+		auto result = new (a_memory) InstanceData();
 		result->lastTri = triangles.begin();
 		return result;
 	}
 
-	PEvaluationResult PBlend2DNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	PoseCache::Handle PBlend2DNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
 		ozz::math::Float2 pt = { GetRequiredInput<float>(0, a_evalContext), GetRequiredInput<float>(1, a_evalContext) };
 
 		auto inst = static_cast<InstanceData*>(a_instanceData);
-		PoseCache::Handle output = a_poseCache.acquire_handle();
+		PoseCache::Handle output = AcquireOutputPose(a_poseCache, a_evalContext);
 
 		constexpr uint8_t maxIterations = 100;
 		uint8_t curIteration = 0;
@@ -24,8 +24,8 @@ namespace Animation::Procedural
 
 		tri_vector_t triangles;
 
-		virtual std::unique_ptr<PNodeInstanceData> CreateInstanceData() override;
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override;
+		virtual PNodeInstanceData* CreateInstanceData(void* a_memory) override;
+		PoseCache::Handle Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext);
 		virtual bool SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir) override;
 
 		inline static Registration _reg{
@@ -2,7 +2,7 @@
 
 namespace Animation::Procedural
 {
-	PEvaluationResult PFixedValueNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	float PFixedValueNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
 		return value;
 	}
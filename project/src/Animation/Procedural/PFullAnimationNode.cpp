@@ -3,22 +3,22 @@
 
 namespace Animation::Procedural
 {
-	std::unique_ptr<PNodeInstanceData> PFullAnimationNode::CreateInstanceData()
+	PNodeInstanceData* PFullAnimationNode::CreateInstanceData(void* a_memory)
 	{
-		auto result = std::make_unique<InstanceData>();
+		auto result = new (a_memory) InstanceData();
 		result->context = anim->CreateContext();
 		return result;
 	}
 
-	PEvaluationResult PFullAnimationNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	PoseCache::Handle PFullAnimationNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
 		auto inst = static_cast<InstanceData*>(a_instanceData);
 
 		if (inputs[0] != UINT64_MAX) {
-			inst->speedMod = std::get<float>(a_evalContext.results[inputs[0]]);
+			inst->speedMod = GetRequiredInput<float>(0, a_evalContext);
 		}
 
-		PoseCache::Handle result = a_poseCache.acquire_handle();
+		PoseCache::Handle result = AcquireOutputPose(a_poseCache, a_evalContext);
 		auto resultSpan = result.get_ozz();
 
 		anim->SampleBoneAnimation(inst->localTime, resultSpan, inst->context.get());
@@ -37,6 +37,12 @@ namespace Animation::Procedural
 		inst->looped = flr;
 	}
 
+	bool PFullAnimationNode::NeedsContinuousEvaluation()
+	{
+		// AdvanceTime uses the speed read by the last Evaluate, so it has to be read every frame.
+		return inputs[0] != UINT64_MAX;
+	}
+
 	void PFullAnimationNode::Synchronize(PNodeInstanceData* a_instanceData, PNodeInstanceData* a_ownerInstance, float a_correctionDelta)
 	{
 		auto inst = static_cast<InstanceData*>(a_instanceData);
@@ -21,9 +21,10 @@ namespace Animation::Procedural
 		std::shared_ptr<IBasicAnimation> anim;
 		float durationInv;
 
-		virtual std::unique_ptr<PNodeInstanceData> CreateInstanceData() override;
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override;
+		virtual PNodeInstanceData* CreateInstanceData(void* a_memory) override;
+		PoseCache::Handle Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext);
 		virtual void AdvanceTime(PNodeInstanceData* a_instanceData, float a_deltaTime) override;
+		virtual bool NeedsContinuousEvaluation() override;
 		virtual void Synchronize(PNodeInstanceData* a_instanceData, PNodeInstanceData* a_ownerInstance, float a_correctionDelta) override;
 		virtual bool SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir) override;
 
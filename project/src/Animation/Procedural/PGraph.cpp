@@ -1,32 +1,228 @@
 #include "PGraph.h"
-#include "PInternalCacheReleaseNode.h"
 #include "PFullAnimationNode.h"
 #include "PVariableNode.h"
 #include "PActorNode.h"
+#include "PTransformRangeNode.h"
+#include "PSmoothValNode.h"
+#include "PBlend1DNode.h"
+#include "PAdditiveBlendNode.h"
+#include "PBatch.h"
 #include "Animation/Generator.h"
 
 namespace Animation::Procedural
 {
+	namespace detail
+	{
+		// Fused transform_range -> smooth_val step, optionally fed straight from a variable.
+		template <bool FromVariable>
+		void EvaluateRangeSmooth(const PPlanStep& a_step, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+		{
+			auto smooth = static_cast<PSmoothValNode*>(a_step.node);
+			auto range = static_cast<PTransformRangeNode*>(a_step.fusedNodes[0]);
+			float value;
+			if constexpr (FromVariable) {
+				value = static_cast<PVariableNode::InstanceData*>(a_evalContext.nodeInstances[a_step.fusedIdxs[1]])->value;
+			} else {
+				value = a_evalContext.results.floats[range->inputSlots[0]];
+			}
+
+			auto inst = static_cast<PSmoothValNode::InstanceData*>(a_evalContext.nodeInstances[a_step.nodeIdx]);
+			a_evalContext.results.floats[smooth->resultSlot] = smooth->Apply(inst, range->Apply(value));
+		}
+
+		template <bool FromVariable>
+		void EvaluateRangeSmoothBatch(const PPlanStep& a_step, std::span<PEvaluationContext* const> a_evalContexts)
+		{
+			auto smooth = static_cast<PSmoothValNode*>(a_step.node);
+			auto range = static_cast<PTransformRangeNode*>(a_step.fusedNodes[0]);
+			ForEachBatchGroup(a_evalContexts, [&](const PBatchGroup& a_group) {
+				ozz::math::SimdFloat4 values;
+				if constexpr (FromVariable) {
+					values = GatherFloats(GetBatchInstances<PVariableNode::InstanceData>(a_group, a_step.fusedIdxs[1]), &PVariableNode::InstanceData::value);
+				} else {
+					values = GatherFloats(a_group, range->inputSlots[0]);
+				}
+
+				auto insts = GetBatchInstances<PSmoothValNode::InstanceData>(a_group, a_step.nodeIdx);
+				ScatterFloats(a_group, smooth->resultSlot, smooth->Apply(insts, range->Apply(values)));
+			});
+		}
+	}
+
 	std::span<ozz::math::SoaTransform> PGraph::Evaluate(InstanceData& a_graphInst, PoseCache& a_poseCache)
 	{
-		auto instIter = a_graphInst.nodeInstances.begin();
-		for (auto iter = nodes.begin(); iter != nodes.end(); iter++) {
-			a_graphInst.results[std::distance(nodes.begin(), iter)] = std::move((*iter)->Evaluate(instIter->get(), a_poseCache, a_graphInst));
-			instIter++;
+		PROFILE_ZONE("PGraph::Evaluate");
+		BeginEvaluate(a_graphInst, a_poseCache);
+		const bool prune = a_graphInst.pruneBranches;
+		PNodeStats* stats = a_graphInst.nodeStats.empty() ? nullptr : a_graphInst.nodeStats.data();
+		if (!parallelBranches.empty()) {
+			EvaluateParallel(a_graphInst, a_poseCache, stats);
+		} else {
+			for (auto& step : plan) {
+				if (prune && step.gate != UINT32_MAX && !IsGateOpen(step.gate, a_graphInst)) {
+					continue;
+				}
+				RunStep(step, a_poseCache, a_graphInst, stats);
+			}
 		}
 
-		return std::get<PoseCache::Handle>(a_graphInst.results[actorNode]).get();
+		return a_graphInst.results.poses[nodes[actorNode]->resultSlot].get();
+	}
+
+	void PGraph::EvaluateBatch(std::span<BatchEntry> a_batch)
+	{
+		PROFILE_ZONE("PGraph::EvaluateBatch");
+		std::vector<InstanceData*> contexts;
+		std::vector<BatchEntry*> entries;
+		contexts.reserve(a_batch.size());
+		entries.reserve(a_batch.size());
+		for (auto& e : a_batch) {
+			if (!parallelBranches.empty() || !e.graphInst->nodeStats.empty()) {
+				e.output = Evaluate(*e.graphInst, *e.poseCache);
+			} else {
+				BeginEvaluate(*e.graphInst, *e.poseCache);
+				contexts.push_back(e.graphInst);
+				entries.push_back(&e);
+			}
+		}
+
+		if (contexts.empty()) {
+			return;
+		}
+
+		// Instances can disagree on which gates are open, so gated steps only run for the instances that need them.
+		std::vector<InstanceData*> active;
+		active.reserve(contexts.size());
+		auto isStepNeeded = [&](const PPlanStep& a_step, InstanceData& a_graphInst) {
+			return a_step.gate == UINT32_MAX || !a_graphInst.pruneBranches || IsGateOpen(a_step.gate, a_graphInst);
+		};
+
+		for (auto& step : plan) {
+			if (step.batchFunc) {
+				std::span<InstanceData* const> stepContexts = contexts;
+				if (step.gate != UINT32_MAX) {
+					active.clear();
+					for (auto c : contexts) {
+						if (isStepNeeded(step, *c)) {
+							active.push_back(c);
+						}
+					}
+					stepContexts = active;
+				}
+
+				if (!stepContexts.empty()) {
+					std::optional<Util::Profiler::ScopedZone> zone;
+					if (Util::Profiler::IsDetailedEnabled()) [[unlikely]] {
+						zone.emplace(nodeZones[step.nodeIdx]);
+					}
+					step.batchFunc(step, stepContexts);
+				}
+			} else {
+				for (auto e : entries) {
+					if (isStepNeeded(step, *e->graphInst)) {
+						RunStep(step, *e->poseCache, *e->graphInst, nullptr);
+					}
+				}
+			}
+		}
+
+		const uint32_t outputSlot = nodes[actorNode]->resultSlot;
+		for (auto e : entries) {
+			e->output = e->graphInst->results.poses[outputSlot].get();
+		}
+	}
+
+	void PGraph::BeginEvaluate(InstanceData& a_graphInst, PoseCache& a_poseCache)
+	{
+		// Slots come from the cache passed to Evaluate, which is the per-thread PosePool scratch in game, so an instance
+		// holds no poses of its own between updates.
+		auto& slots = a_graphInst.poseSlots;
+		slots.clear();
+		for (size_t i = 0; i < numPoseSlots; i++) {
+			slots.push_back(a_poseCache.acquire_handle());
+		}
+
+		if (a_graphInst.pruneBranches) {
+			a_graphInst.gateStates.assign(branchGates.size(), kGateUnknown);
+		}
+	}
+
+	void PGraph::EvaluateParallel(InstanceData& a_graphInst, PoseCache& a_poseCache, PNodeStats* a_stats)
+	{
+		auto& caches = a_graphInst.branchPoseCaches;
+		if (caches.size() != parallelBranches.size()) {
+			caches.clear();
+			for (size_t i = 0; i < parallelBranches.size(); i++) {
+				caches.emplace_back(std::make_unique<PoseCache>())->set_pose_size(a_poseCache.pose_size());
+			}
+		}
+
+		// Branches are only read by the steps after them, and the steps before them are the only ones they read from.
+		// Branch pruning is skipped here, since gates rely on the serial order.
+		const uint32_t branchesBegin = parallelBranches.front().first;
+		const uint32_t branchesEnd = parallelBranches.back().second;
+		for (uint32_t i = 0; i < branchesBegin; i++) {
+			RunStep(plan[i], a_poseCache, a_graphInst, a_stats);
+		}
+
+		std::for_each(std::execution::par, parallelBranches.begin(), parallelBranches.end(), [&](const std::pair<uint32_t, uint32_t>& a_branch) {
+			PoseCache& cache = *caches[std::distance(parallelBranches.data(), &a_branch)];
+			for (uint32_t i = a_branch.first; i < a_branch.second; i++) {
+				RunStep(plan[i], cache, a_graphInst, a_stats);
+			}
+		});
+
+		for (uint32_t i = branchesEnd; i < plan.size(); i++) {
+			RunStep(plan[i], a_poseCache, a_graphInst, a_stats);
+		}
+	}
+
+	void PGraph::RunStep(const PPlanStep& a_step, PoseCache& a_poseCache, InstanceData& a_graphInst, PNodeStats* a_stats)
+	{
+		// Per node zones are opt-in, since timing every step costs more than most value nodes do.
+		std::optional<Util::Profiler::ScopedZone> zone;
+		if (Util::Profiler::IsDetailedEnabled()) [[unlikely]] {
+			zone.emplace(nodeZones[a_step.nodeIdx]);
+		}
+		if (a_stats) [[unlikely]] {
+			// Fused steps are counted against their last node.
+			auto& s = a_stats[a_step.nodeIdx];
+			const size_t acquiredBefore = a_poseCache.acquired_count();
+			const uint64_t start = Util::Profiler::ReadTimestamp();
+			a_step.func(a_step, a_poseCache, a_graphInst);
+			s.evaluateTicks += Util::Profiler::ReadTimestamp() - start;
+			s.evaluateCalls++;
+			s.posesAcquired += a_poseCache.acquired_count() - acquiredBefore;
+		} else {
+			a_step.func(a_step, a_poseCache, a_graphInst);
+		}
+	}
+
+	void PGraph::ReleasePoses(InstanceData& a_graphInst)
+	{
+		// Slot outputs are borrowed from poseSlots, so they're reset before the slots themselves are released.
+		for (auto& p : a_graphInst.results.poses) {
+			p.reset();
+		}
+		a_graphInst.poseSlots.clear();
 	}
 
 	bool PGraph::AdvanceTime(InstanceData& a_graphInst, float a_deltaTime)
 	{
-		auto instIter = a_graphInst.nodeInstances.begin();
-		for (auto& n : nodes) {
-			n->AdvanceTime(instIter->get(), a_deltaTime);
-			instIter++;
+		PNodeStats* stats = a_graphInst.nodeStats.empty() ? nullptr : a_graphInst.nodeStats.data();
+		for (size_t i = 0; i < nodes.size(); i++) {
+			if (stats) [[unlikely]] {
+				auto& s = stats[i];
+				const uint64_t start = Util::Profiler::ReadTimestamp();
+				nodes[i]->AdvanceTime(a_graphInst.nodeInstances[i], a_deltaTime);
+				s.advanceTicks += Util::Profiler::ReadTimestamp() - start;
+				s.advanceCalls++;
+			} else {
+				nodes[i]->AdvanceTime(a_graphInst.nodeInstances[i], a_deltaTime);
+			}
 		}
 		if (loopTrackingNode != UINT64_MAX) {
-			return static_cast<PFullAnimationNode::InstanceData*>(a_graphInst.nodeInstances[loopTrackingNode].get())->looped;
+			return static_cast<PFullAnimationNode::InstanceData*>(a_graphInst.nodeInstances[loopTrackingNode])->looped;
 		}
 		return false;
 	}
@@ -46,8 +242,8 @@ namespace Animation::Procedural
 					if (oN->syncId == n->syncId && oN->GetTypeInfo() == n->GetTypeInfo()) {
 						auto& d = a_graphInst.syncMap.emplace_back();
 						d.node = n.get();
-						d.selfInstData = a_graphInst.nodeInstances[std::distance(nodes.begin(), selfIter)].get();
-						d.ownerInstData = a_ownerInst.nodeInstances[std::distance(a_ownerGraph->nodes.begin(), ownerIter)].get();
+						d.selfInstData = a_graphInst.nodeInstances[std::distance(nodes.begin(), selfIter)];
+						d.ownerInstData = a_ownerInst.nodeInstances[std::distance(a_ownerGraph->nodes.begin(), ownerIter)];
 						break;
 					}
 				}
@@ -63,14 +259,76 @@ namespace Animation::Procedural
 
 	void PGraph::InitInstanceData(InstanceData& a_graphInst)
 	{
-		a_graphInst.nodeInstances.reserve(nodes.size());
-		for (auto& n : nodes) {
-			a_graphInst.nodeInstances.emplace_back(n->CreateInstanceData());
-			if (IsNodeOfType<PVariableNode>(n.get())) {
-				a_graphInst.variableMap.emplace(static_cast<PVariableNode*>(n.get())->name, static_cast<PVariableInstance*>(a_graphInst.nodeInstances.back().get()));
+		a_graphInst.instanceArena.allocate(instanceArenaSize, instanceArenaAlignment);
+		a_graphInst.nodeInstances.resize(nodes.size(), nullptr);
+		for (size_t i = 0; i < nodes.size(); i++) {
+			if (instanceOffsets[i] != UINT64_MAX) {
+				a_graphInst.nodeInstances[i] = a_graphInst.instanceArena.create(nodes[i].get(), instanceOffsets[i]);
+			}
+		}
+
+		a_graphInst.variables.reserve(variableNodes.size());
+		for (auto& [name, idx] : variableNodes) {
+			a_graphInst.variables.emplace_back(name, static_cast<PVariableInstance*>(a_graphInst.nodeInstances[idx]));
+		}
+		a_graphInst.results.resize(resultCounts);
+		a_graphInst.poseSlots.reserve(numPoseSlots);
+		a_graphInst.pruneBranches = branchPruning;
+	}
+
+	void PGraph::SetNodeStatsEnabled(InstanceData& a_graphInst, bool a_enabled)
+	{
+		a_graphInst.nodeStats.clear();
+		if (a_enabled) {
+			a_graphInst.nodeStats.resize(nodes.size());
+		} else {
+			a_graphInst.nodeStats.shrink_to_fit();
+		}
+	}
+
+	void PGraph::SetBranchPruningEnabled(InstanceData& a_graphInst, bool a_enabled)
+	{
+		a_graphInst.pruneBranches = a_enabled;
+	}
+
+	std::vector<PGraph::NodeCost> PGraph::GetNodeCostReport(const InstanceData& a_graphInst, bool a_byType) const
+	{
+		std::vector<NodeCost> result;
+		if (a_graphInst.nodeStats.size() != nodes.size()) {
+			return result;
+		}
+
+		std::unordered_map<std::string_view, size_t> typeEntries;
+		for (size_t i = 0; i < nodes.size(); i++) {
+			const auto& s = a_graphInst.nodeStats[i];
+			const auto typeInfo = nodes[i]->GetTypeInfo();
+			const std::string_view typeName = typeInfo ? typeInfo->typeName : "internal";
+
+			NodeCost* entry = nullptr;
+			if (a_byType) {
+				auto [iter, inserted] = typeEntries.emplace(typeName, result.size());
+				if (inserted) {
+					result.emplace_back().typeName = typeName;
+				}
+				entry = &result[iter->second];
+			} else {
+				entry = &result.emplace_back();
+				entry->nodeIdx = i;
+				entry->typeName = typeName;
 			}
+
+			entry->nodeCount++;
+			entry->evaluateCalls += s.evaluateCalls;
+			entry->evaluateMs += Util::Profiler::TicksToMs(s.evaluateTicks);
+			entry->advanceCalls += s.advanceCalls;
+			entry->advanceMs += Util::Profiler::TicksToMs(s.advanceTicks);
+			entry->posesAcquired += s.posesAcquired;
 		}
-		a_graphInst.results.resize(nodes.size());
+
+		std::sort(result.begin(), result.end(), [](const NodeCost& a, const NodeCost& b) {
+			return (a.evaluateMs + a.advanceMs) > (b.evaluateMs + b.advanceMs);
+		});
+		return result;
 	}
 
 	std::unique_ptr<Generator> PGraph::CreateGenerator()
@@ -80,18 +338,165 @@ namespace Animation::Procedural
 
 	size_t PGraph::GetSizeBytes()
 	{
-		size_t result = sizeof(PGraph) + std::span(nodes).size_bytes();
+		size_t result = sizeof(PGraph) + Util::Memory::GetHeapBytes(nodes) + Util::Memory::GetHeapBytes(nodeZones) +
+		                Util::Memory::GetHeapBytes(instanceOffsets) + Util::Memory::GetHeapBytes(variableNodes) +
+		                Util::Memory::GetHeapBytes(plan) + Util::Memory::GetHeapBytes(branchGates) +
+		                Util::Memory::GetHeapBytes(parallelBranches);
 		for (auto& n : nodes) {
 			result += n->GetSizeBytes();
 		}
 		return result;
 	}
 
+	size_t PGraph::FoldConstants()
+	{
+		auto& nodeTypes = GetRegisteredNodeTypes();
+		const PNode::Registration* fixedValType = nodeTypes.at("fixed_val");
+		const PNode::Registration* fixedVecType = nodeTypes.at("fixed_vec");
+
+		std::unordered_map<PNode*, bool> constants;
+		const auto IsConstant = [&](PNode* a_node) {
+			return IsConstantNode(a_node, fixedValType, fixedVecType, constants);
+		};
+
+		// Evaluate every constant node once, inputs first, in a scratch context.
+		PEvaluationContext scratch;
+		PoseCache scratchCache;
+		std::array<uint32_t, PResultBuffers::kBufferCount> counts{};
+		std::vector<PNode*> evalOrder;
+		for (auto& n : nodes) {
+			if (IsConstant(n.get())) {
+				CollectConstantNode(n.get(), counts, evalOrder);
+			}
+		}
+
+		scratch.results.resize(counts);
+		scratch.nodeInstances.assign(1, nullptr);
+		std::unordered_map<PNode*, float> constantValues;
+		for (auto n : evalOrder) {
+			const PPlanStep step{ n->GetEvaluateFunc(), n, 0 };
+			step.func(step, scratchCache, scratch);
+			if (n->resultType == PEvaluationType<float>) {
+				constantValues[n] = scratch.results.floats[n->resultSlot];
+			}
+		}
+
+		// Replace each constant that a non-constant node reads with a fixed node.
+		std::vector<std::unique_ptr<PNode>> literals;
+		std::unordered_map<PNode*, PNode*> literalMap;
+		for (auto& n : nodes) {
+			if (IsConstant(n.get()))
+				continue;
+
+			for (auto& i : n->inputs) {
+				auto input = reinterpret_cast<PNode*>(i);
+				if (!input || !IsConstant(input))
+					continue;
+
+				if (input->GetTypeInfo() == fixedValType || input->GetTypeInfo() == fixedVecType)
+					continue;
+
+				auto& literal = literalMap[input];
+				if (!literal) {
+					std::vector<PEvaluationResult> values;
+					if (input->resultType == PEvaluationType<float>) {
+						values.emplace_back(constantValues[input]);
+						literals.push_back(fixedValType->createFunctor());
+					} else {
+						const auto& vec = scratch.results.vectors[input->resultSlot];
+						for (float f : { vec.x, vec.y, vec.z, vec.w }) {
+							values.emplace_back(f);
+						}
+						literals.push_back(fixedVecType->createFunctor());
+					}
+					literals.back()->SetCustomValues(values, nullptr, {});
+					literal = literals.back().get();
+					if (input->resultType == PEvaluationType<float>) {
+						constantValues[literal] = constantValues[input];
+					}
+				}
+				i = reinterpret_cast<uint64_t>(literal);
+			}
+		}
+
+		for (auto n : evalOrder) {
+			n->inputSlots.clear();
+			n->resultSlot = UINT32_MAX;
+		}
+
+		// A blend whose constant weight selects a single input is replaced by that input.
+		std::unordered_map<uint64_t, uint64_t> redirects;
+		for (auto& n : nodes) {
+			if (!IsNodeOfType<PBlend1DNode>(n.get()) && !IsNodeOfType<PAdditiveBlendNode>(n.get()))
+				continue;
+
+			auto weight = constantValues.find(reinterpret_cast<PNode*>(n->inputs[2]));
+			if (weight == constantValues.end())
+				continue;
+
+			const float w = weight->second;
+			uint64_t replacement = 0;
+			if (IsNodeOfType<PBlend1DNode>(n.get())) {
+				replacement = w >= 1.0f ? n->inputs[0] : (w <= 0.0f ? n->inputs[1] : 0);
+			} else if (IsNodeOfType<PAdditiveBlendNode>(n.get()) && w == 0.0f) {
+				replacement = n->inputs[1];
+			}
+
+			if (replacement != 0) {
+				redirects[reinterpret_cast<uint64_t>(n.get())] = replacement;
+			}
+		}
+
+		const auto Resolve = [&](uint64_t a_ptr) {
+			for (auto iter = redirects.find(a_ptr); iter != redirects.end(); iter = redirects.find(a_ptr)) {
+				a_ptr = iter->second;
+			}
+			return a_ptr;
+		};
+
+		for (auto& n : nodes) {
+			for (auto& i : n->inputs) {
+				i = Resolve(i);
+			}
+		}
+		actorNode = Resolve(actorNode);
+
+		const size_t numLiterals = literals.size();
+		for (auto& l : literals) {
+			nodes.push_back(std::move(l));
+		}
+
+		// Remove everything the output no longer reaches.
+		std::unordered_set<PNode*> reachable;
+		std::vector<PNode*> stack{ reinterpret_cast<PNode*>(actorNode) };
+		while (!stack.empty()) {
+			auto n = stack.back();
+			stack.pop_back();
+			if (!reachable.insert(n).second)
+				continue;
+
+			for (auto& i : n->inputs) {
+				if (i != 0) {
+					stack.push_back(reinterpret_cast<PNode*>(i));
+				}
+			}
+		}
+
+		// Literals added above replace folded nodes, so only count what the graph actually shrank by.
+		const size_t erased = std::erase_if(nodes, [&](const std::unique_ptr<PNode>& a_node) { return !reachable.contains(a_node.get()); });
+		return erased > numLiterals ? erased - numLiterals : 0;
+	}
+
 	bool PGraph::SortNodes(std::vector<PNode*>& a_sortedNodes)
 	{
 		std::unordered_set<PNode*> visited;
 		std::unordered_set<PNode*> recursionStack;
 
+		// Start from the output so that a node's conditional inputs are always sorted after its other inputs.
+		if (auto output = reinterpret_cast<PNode*>(actorNode); output && !DepthFirstNodeSort(output, 0, visited, recursionStack, a_sortedNodes)) {
+			return false;
+		}
+
 		for (auto& node : nodes) {
 			if (visited.find(node.get()) == visited.end()) {
 				if (!DepthFirstNodeSort(node.get(), 0, visited, recursionStack, a_sortedNodes)) {
@@ -103,12 +508,11 @@ namespace Animation::Procedural
 		return true;
 	}
 
-	void PGraph::InsertCacheReleaseNodes(std::vector<PNode*>& a_sortedNodes)
+	void PGraph::AllocatePoseSlots(std::vector<PNode*>& a_sortedNodes)
 	{
-		std::map<PNode*, size_t> lastUsageMap;
-		for (auto iter = a_sortedNodes.begin(); iter != a_sortedNodes.end(); iter++) {
-			auto& n = *iter;
-			size_t idx = std::distance(a_sortedNodes.begin(), iter);
+		std::unordered_map<PNode*, size_t> lastUsageMap;
+		for (size_t idx = 0; idx < a_sortedNodes.size(); idx++) {
+			auto n = a_sortedNodes[idx];
 			lastUsageMap[n] = idx;
 			for (auto& i : n->inputs) {
 				if (i == 0)
@@ -118,19 +522,56 @@ namespace Animation::Procedural
 			}
 		}
 
-		std::vector<std::pair<PNode*, size_t>> sortedLastUsages(lastUsageMap.begin(), lastUsageMap.end());
-		std::sort(sortedLastUsages.begin(), sortedLastUsages.end(),
-			[](const auto& a, const auto& b) { return a.second > b.second; });
+		// Slots are handed out like registers: a slot is reused once the last node reading its pose has run. The graph's
+		// output is never freed, so it stays valid after Evaluate returns.
+		const PNode* outputNode = reinterpret_cast<PNode*>(actorNode);
+		std::vector<uint16_t> freeSlots;
+		numPoseSlots = 0;
 
-		for (const auto& [n, idx] : sortedLastUsages) {
-			if (auto typeInfo = n->GetTypeInfo(); !typeInfo || typeInfo->output != PEvaluationType<PoseCache::Handle> || n == reinterpret_cast<PNode*>(actorNode)) {
+		const auto FreeSlot = [&](PNode* a_node, size_t a_idx) {
+			if (a_node->poseSlot != UINT16_MAX && a_node != outputNode && lastUsageMap[a_node] == a_idx &&
+				std::find(freeSlots.begin(), freeSlots.end(), a_node->poseSlot) == freeSlots.end()) {
+				freeSlots.push_back(a_node->poseSlot);
+			}
+		};
+
+		for (size_t idx = 0; idx < a_sortedNodes.size(); idx++) {
+			auto n = a_sortedNodes[idx];
+			n->poseSlot = UINT16_MAX;
+			n->inPlaceInputs = 0;
+			if (auto typeInfo = n->GetTypeInfo(); !typeInfo || typeInfo->output != PEvaluationType<PoseCache::Handle>)
 				continue;
+
+			// A node that only modifies its input can write to the input's slot if nothing reads the input afterwards.
+			const uint32_t modifiedInputs = n->GetModifiedPoseInputs();
+			for (size_t i = 0; i < n->inputs.size() && i < 32; i++) {
+				auto input = reinterpret_cast<PNode*>(n->inputs[i]);
+				if (!(modifiedInputs & (1u << i)) || !input || input == outputNode || input->poseSlot == UINT16_MAX ||
+					lastUsageMap[input] != idx || std::count(n->inputs.begin(), n->inputs.end(), n->inputs[i]) != 1) {
+					continue;
+				}
+
+				n->poseSlot = input->poseSlot;
+				n->inPlaceInputs |= 1u << i;
+				break;
 			}
 
-			auto& releaseNode = nodes.emplace_back(std::make_unique<PInternalCacheReleaseNode>());
-			releaseNode->inputs.emplace_back(reinterpret_cast<uint64_t>(n));
+			// Input slots are only freed after the output slot is picked, so nodes never write over a pose they are reading.
+			if (n->poseSlot == UINT16_MAX) {
+				if (!freeSlots.empty()) {
+					n->poseSlot = freeSlots.back();
+					freeSlots.pop_back();
+				} else {
+					n->poseSlot = static_cast<uint16_t>(numPoseSlots++);
+				}
+			}
 
-			a_sortedNodes.insert(a_sortedNodes.begin() + (idx + 1), releaseNode.get());
+			for (auto& i : n->inputs) {
+				if (auto input = reinterpret_cast<PNode*>(i); input && input->poseSlot != n->poseSlot) {
+					FreeSlot(input, idx);
+				}
+			}
+			FreeSlot(n, idx);
 		}
 	}
 
@@ -178,6 +619,295 @@ namespace Animation::Procedural
 		}
 
 		nodes = std::move(result);
+
+		nodeZones.clear();
+		nodeZones.reserve(nodes.size());
+		for (auto& n : nodes) {
+			auto typeInfo = n->GetTypeInfo();
+			nodeZones.push_back(Util::Profiler::RegisterZone(std::format("PGraph::Evaluate::{}", typeInfo ? typeInfo->typeName : "internal")));
+		}
+	}
+
+	void PGraph::AssignResultSlots()
+	{
+		resultCounts = {};
+		for (auto& n : nodes) {
+			n->resultType = n->GetTypeInfo()->output;
+			n->resultSlot = resultCounts[PResultBuffers::GetBuffer(n->resultType)]++;
+		}
+
+		for (auto& n : nodes) {
+			n->inputSlots.clear();
+			for (auto& i : n->inputs) {
+				n->inputSlots.push_back(i != UINT64_MAX ? nodes[i]->resultSlot : UINT32_MAX);
+			}
+		}
+	}
+
+	std::vector<uint32_t> PGraph::BuildBranchGates()
+	{
+		// Find the innermost gate each node is only needed through. Nodes are walked from consumers to producers, and a
+		// node reached through several paths ends up with the innermost gate shared by all of them.
+		branchGates.clear();
+		std::vector<uint32_t> owners(nodes.size(), UINT32_MAX);
+		std::vector<bool> reached(nodes.size(), false);
+
+		const auto CommonGate = [&](uint32_t a_lhs, uint32_t a_rhs) {
+			while (a_lhs != a_rhs && a_lhs != UINT32_MAX && a_rhs != UINT32_MAX) {
+				if (branchGates[a_lhs].depth >= branchGates[a_rhs].depth) {
+					a_lhs = branchGates[a_lhs].parent;
+				} else {
+					a_rhs = branchGates[a_rhs].parent;
+				}
+			}
+			return a_lhs == a_rhs ? a_lhs : UINT32_MAX;
+		};
+
+		if (actorNode < nodes.size()) {
+			reached[actorNode] = true;
+		}
+
+		for (size_t i = nodes.size(); i-- > 0;) {
+			auto& n = nodes[i];
+			const uint32_t conditional = n->GetConditionalInputs();
+			for (size_t j = 0; j < n->inputs.size(); j++) {
+				const uint64_t input = n->inputs[j];
+				if (input == UINT64_MAX)
+					continue;
+
+				uint32_t owner = owners[i];
+				if (j < 32 && (conditional & (1u << j))) {
+					owner = static_cast<uint32_t>(branchGates.size());
+					branchGates.push_back({ static_cast<uint32_t>(i), static_cast<uint32_t>(j), owners[i], owners[i] != UINT32_MAX ? branchGates[owners[i]].depth + 1 : 0 });
+				}
+
+				owners[input] = reached[input] ? CommonGate(owners[input], owner) : owner;
+				reached[input] = true;
+			}
+		}
+
+		for (size_t i = 0; i < nodes.size(); i++) {
+			if (!nodes[i]->NeedsContinuousEvaluation())
+				continue;
+
+			for (uint32_t g = owners[i]; g != UINT32_MAX && !branchGates[g].alwaysOpen; g = branchGates[g].parent) {
+				branchGates[g].alwaysOpen = true;
+			}
+		}
+
+		return owners;
+	}
+
+	void PGraph::BuildPlan()
+	{
+		const std::vector<uint32_t> gateOwners = BuildBranchGates();
+
+		std::vector<uint32_t> useCounts(nodes.size(), 0);
+		for (auto& n : nodes) {
+			for (auto& i : n->inputs) {
+				if (i != UINT64_MAX) {
+					useCounts[i]++;
+				}
+			}
+		}
+
+		// A node can only be fused into its consumer if nothing else reads its result.
+		auto fusableInput = [&](PNode* a_node, size_t a_idx) -> uint64_t {
+			const uint64_t input = a_node->inputs[a_idx];
+			return input != UINT64_MAX && input != actorNode && useCounts[input] == 1 ? input : UINT64_MAX;
+		};
+
+		plan.clear();
+		plan.reserve(nodes.size());
+		std::vector<bool> fused(nodes.size(), false);
+		for (size_t i = 0; i < nodes.size(); i++) {
+			auto& n = nodes[i];
+			auto& step = plan.emplace_back(n->GetEvaluateFunc(), n.get(), static_cast<uint32_t>(i));
+			step.gate = gateOwners[i];
+			step.batchFunc = n->GetEvaluateBatchFunc();
+
+			if (!IsNodeOfType<PSmoothValNode>(n.get())) {
+				continue;
+			}
+
+			const uint64_t rangeIdx = fusableInput(n.get(), 0);
+			if (rangeIdx == UINT64_MAX || !IsNodeOfType<PTransformRangeNode>(nodes[rangeIdx].get())) {
+				continue;
+			}
+
+			step.func = &detail::EvaluateRangeSmooth<false>;
+			step.batchFunc = &detail::EvaluateRangeSmoothBatch<false>;
+			step.fusedNodes[0] = nodes[rangeIdx].get();
+			step.fusedIdxs[0] = static_cast<uint32_t>(rangeIdx);
+			fused[rangeIdx] = true;
+
+			const uint64_t varIdx = fusableInput(nodes[rangeIdx].get(), 0);
+			if (varIdx != UINT64_MAX && IsNodeOfType<PVariableNode>(nodes[varIdx].get())) {
+				step.func = &detail::EvaluateRangeSmooth<true>;
+				step.batchFunc = &detail::EvaluateRangeSmoothBatch<true>;
+				step.fusedNodes[1] = nodes[varIdx].get();
+				step.fusedIdxs[1] = static_cast<uint32_t>(varIdx);
+				fused[varIdx] = true;
+			}
+		}
+
+		// Fused nodes only feed nodes later in the order, so dropping their own steps keeps the plan sorted.
+		std::erase_if(plan, [&](const PPlanStep& a_step) { return fused[a_step.nodeIdx]; });
+
+		parallelBranches.clear();
+		if (parallelEvaluation) {
+			BuildParallelBranches();
+		}
+	}
+
+	void PGraph::BuildParallelBranches()
+	{
+		std::vector<std::vector<uint32_t>> consumers(nodes.size());
+		for (size_t i = 0; i < nodes.size(); i++) {
+			for (auto& input : nodes[i]->inputs) {
+				if (input != UINT64_MAX) {
+					consumers[input].push_back(static_cast<uint32_t>(i));
+				}
+			}
+		}
+
+		// Finds the nodes that are only needed through input a_inputIdx of a_fork. Returns false if any of them can't be
+		// evaluated in parallel.
+		std::vector<uint8_t> region(nodes.size());
+		const auto FindBranch = [&](size_t a_fork, size_t a_inputIdx, uint8_t a_id, size_t& a_sizeOut) {
+			const uint64_t root = nodes[a_fork]->inputs[a_inputIdx];
+			a_sizeOut = 0;
+			if (root == UINT64_MAX || std::count(nodes[a_fork]->inputs.begin(), nodes[a_fork]->inputs.end(), root) != 1 ||
+				consumers[root].size() != 1) {
+				return true;
+			}
+
+			// Nodes are sorted, so every consumer of a node is checked before the node itself.
+			region[root] = a_id;
+			for (size_t i = root + 1; i-- > 0;) {
+				if (i != root && (consumers[i].empty() || !std::all_of(consumers[i].begin(), consumers[i].end(), [&](uint32_t c) { return region[c] == a_id; }))) {
+					continue;
+				}
+
+				region[i] = a_id;
+				a_sizeOut++;
+				if (!nodes[i]->CanEvaluateInParallel()) {
+					return false;
+				}
+			}
+			return true;
+		};
+
+		// Fork at the node whose branches save the most work by running side by side.
+		size_t bestFork = SIZE_MAX;
+		size_t bestSaving = 0;
+		for (size_t i = 0; i < nodes.size(); i++) {
+			if (nodes[i]->inputs.size() < 2 || nodes[i]->inputs.size() >= UINT8_MAX)
+				continue;
+
+			std::fill(region.begin(), region.end(), 0);
+			size_t total = 0;
+			size_t largest = 0;
+			size_t numBranches = 0;
+			for (size_t j = 0; j < nodes[i]->inputs.size(); j++) {
+				size_t size;
+				if (FindBranch(i, j, static_cast<uint8_t>(j + 1), size) && size > 0) {
+					total += size;
+					largest = std::max(largest, size);
+					numBranches++;
+				}
+			}
+
+			if (numBranches >= 2 && total >= PARALLEL_MIN_NODES && total - largest > bestSaving) {
+				bestFork = i;
+				bestSaving = total - largest;
+			}
+		}
+
+		if (bestFork == SIZE_MAX) {
+			return;
+		}
+
+		// Region 0 is evaluated serially. Branches that can't run in parallel are left in it.
+		std::fill(region.begin(), region.end(), 0);
+		std::vector<uint8_t> branchIds;
+		for (size_t j = 0; j < nodes[bestFork]->inputs.size(); j++) {
+			size_t size;
+			const uint8_t id = static_cast<uint8_t>(branchIds.size() + 1);
+			if (FindBranch(bestFork, j, id, size) && size > 0) {
+				branchIds.push_back(id);
+			} else {
+				std::replace(region.begin(), region.end(), id, uint8_t{ 0 });
+			}
+		}
+
+		// Poses are acquired on demand from each branch's own cache instead of from the shared slots, and a pose can only be
+		// modified in place if everything else reading it runs on the same thread.
+		numPoseSlots = 0;
+		for (size_t i = 0; i < nodes.size(); i++) {
+			auto& n = nodes[i];
+			n->poseSlot = UINT16_MAX;
+			for (size_t j = 0; j < n->inputs.size() && j < 32; j++) {
+				const uint64_t input = n->inputs[j];
+				if (!(n->inPlaceInputs & (1u << j)) || std::all_of(consumers[input].begin(), consumers[input].end(), [&](uint32_t c) { return region[c] == region[i]; })) {
+					continue;
+				}
+				n->inPlaceInputs &= ~(1u << j);
+			}
+		}
+
+		std::vector<PPlanStep> ordered;
+		ordered.reserve(plan.size());
+		auto forkStep = std::find_if(plan.begin(), plan.end(), [&](const PPlanStep& a_step) { return a_step.nodeIdx == bestFork; });
+		std::copy_if(plan.begin(), forkStep, std::back_inserter(ordered), [&](const PPlanStep& a_step) { return region[a_step.nodeIdx] == 0; });
+		for (auto id : branchIds) {
+			const uint32_t begin = static_cast<uint32_t>(ordered.size());
+			std::copy_if(plan.begin(), forkStep, std::back_inserter(ordered), [&](const PPlanStep& a_step) { return region[a_step.nodeIdx] == id; });
+			parallelBranches.emplace_back(begin, static_cast<uint32_t>(ordered.size()));
+		}
+		std::copy(forkStep, plan.end(), std::back_inserter(ordered));
+		plan = std::move(ordered);
+	}
+
+	void PGraph::LayoutInstanceData()
+	{
+		instanceOffsets.assign(nodes.size(), UINT64_MAX);
+		instanceArenaSize = 0;
+		instanceArenaAlignment = alignof(std::max_align_t);
+		variableNodes.clear();
+
+		for (size_t i = 0; i < nodes.size(); i++) {
+			auto n = nodes[i].get();
+			const auto layout = n->GetInstanceLayout();
+			if (layout.size > 0) {
+				instanceArenaSize = (instanceArenaSize + layout.alignment - 1) & ~(layout.alignment - 1);
+				instanceOffsets[i] = instanceArenaSize;
+				instanceArenaSize += layout.size;
+				instanceArenaAlignment = std::max(instanceArenaAlignment, layout.alignment);
+			}
+
+			if (IsNodeOfType<PVariableNode>(n)) {
+				variableNodes.emplace_back(static_cast<PVariableNode*>(n)->name, i);
+			}
+		}
+
+		// If a name is used more than once, the first node in evaluation order wins.
+		std::stable_sort(variableNodes.begin(), variableNodes.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+		variableNodes.erase(std::unique(variableNodes.begin(), variableNodes.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), variableNodes.end());
+	}
+
+	bool PGraph::IsGateOpen(uint32_t a_gate, InstanceData& a_graphInst)
+	{
+		auto& state = a_graphInst.gateStates[a_gate];
+		if (state == kGateUnknown) {
+			const auto& g = branchGates[a_gate];
+			bool open = g.parent == UINT32_MAX || IsGateOpen(g.parent, a_graphInst);
+			if (open && !g.alwaysOpen) {
+				open = !(nodes[g.nodeIdx]->GetSkippedInputs(a_graphInst) & (1u << g.inputIdx));
+			}
+			state = open ? kGateOpen : kGateClosed;
+		}
+		return state == kGateOpen;
 	}
 
 	bool PGraph::DepthFirstNodeSort(PNode* a_node, size_t a_depth, std::unordered_set<PNode*>& a_visited, std::unordered_set<PNode*>& a_recursionStack, std::vector<PNode*>& a_sortedNodes)
@@ -190,20 +920,25 @@ namespace Animation::Procedural
 		a_visited.insert(a_node);
 		a_recursionStack.insert(a_node);
 
-		for (uint64_t ptr : a_node->inputs) {
-			if (ptr == 0)
-				continue;
-
-			auto dependency = reinterpret_cast<PNode*>(ptr);
-			if (a_recursionStack.find(dependency) != a_recursionStack.end()) {
-				// Cycle detected in graph.
-				return false;
-			}
+		// Conditional inputs are visited last, so whatever decides whether they're needed is evaluated first.
+		const uint32_t conditional = a_node->GetConditionalInputs();
+		for (bool visitConditional : { false, true }) {
+			for (size_t i = 0; i < a_node->inputs.size(); i++) {
+				const uint64_t ptr = a_node->inputs[i];
+				if (ptr == 0 || (i < 32 && (conditional & (1u << i))) != visitConditional)
+					continue;
 
-			if (a_visited.find(dependency) == a_visited.end()) {
-				if (!DepthFirstNodeSort(dependency, a_depth + 1, a_visited, a_recursionStack, a_sortedNodes)) {
+				auto dependency = reinterpret_cast<PNode*>(ptr);
+				if (a_recursionStack.find(dependency) != a_recursionStack.end()) {
+					// Cycle detected in graph.
 					return false;
 				}
+
+				if (a_visited.find(dependency) == a_visited.end()) {
+					if (!DepthFirstNodeSort(dependency, a_depth + 1, a_visited, a_recursionStack, a_sortedNodes)) {
+						return false;
+					}
+				}
 			}
 		}
 
@@ -211,4 +946,45 @@ namespace Animation::Procedural
 		a_sortedNodes.push_back(a_node);
 		return true;
 	}
+
+	bool PGraph::IsConstantNode(PNode* a_node, const PNode::Registration* a_fixedValType, const PNode::Registration* a_fixedVecType, std::unordered_map<PNode*, bool>& a_constants)
+	{
+		if (auto iter = a_constants.find(a_node); iter != a_constants.end()) {
+			return iter->second;
+		}
+
+		// A node is constant if it's a fixed node, or a stateless value or vector node whose connected inputs are all constant.
+		// Nodes are marked non-constant until proven otherwise, so a cycle ends the recursion instead of looping forever.
+		a_constants[a_node] = false;
+		const auto typeInfo = a_node->GetTypeInfo();
+		bool result = typeInfo == a_fixedValType || typeInfo == a_fixedVecType;
+		if (!result && (typeInfo->output == PEvaluationType<float> || typeInfo->output == PEvaluationType<ozz::math::Float4>) &&
+			a_node->GetInstanceLayout().size == 0) {
+			size_t connected = 0;
+			result = std::all_of(a_node->inputs.begin(), a_node->inputs.end(), [&](uint64_t a_input) {
+				return a_input == 0 || (connected++, IsConstantNode(reinterpret_cast<PNode*>(a_input), a_fixedValType, a_fixedVecType, a_constants));
+			});
+			result = result && connected > 0;
+		}
+
+		a_constants[a_node] = result;
+		return result;
+	}
+
+	void PGraph::CollectConstantNode(PNode* a_node, std::array<uint32_t, PResultBuffers::kBufferCount>& a_counts, std::vector<PNode*>& a_evalOrder)
+	{
+		if (a_node->resultSlot != UINT32_MAX)
+			return;
+
+		a_node->inputSlots.clear();
+		for (auto& i : a_node->inputs) {
+			if (i != 0) {
+				CollectConstantNode(reinterpret_cast<PNode*>(i), a_counts, a_evalOrder);
+			}
+			a_node->inputSlots.push_back(i != 0 ? reinterpret_cast<PNode*>(i)->resultSlot : UINT32_MAX);
+		}
+		a_node->resultType = a_node->GetTypeInfo()->output;
+		a_node->resultSlot = a_counts[PResultBuffers::GetBuffer(a_node->resultType)]++;
+		a_evalOrder.push_back(a_node);
+	}
 }
\ No newline at end of file
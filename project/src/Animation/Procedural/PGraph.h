@@ -2,6 +2,7 @@
 #include "PNode.h"
 #include "Animation/PoseCache.h"
 #include "Animation/IAnimationFile.h"
+#include "Util/Profiler.h"
 
 namespace Serialization
 {
@@ -14,30 +15,120 @@ namespace Animation::Procedural
 	{
 	public:
 		inline static constexpr size_t MAX_DEPTH{ 100 };
+		// Minimum number of nodes in a graph's parallel branches before they're worth running on separate threads.
+		inline static constexpr size_t PARALLEL_MIN_NODES{ 24 };
 		using InstanceData = PEvaluationContext;
 
+		enum GATE_STATE : uint8_t
+		{
+			kGateUnknown = 0,
+			kGateOpen = 1,
+			kGateClosed = 2
+		};
+
+		struct BranchGate
+		{
+			uint32_t nodeIdx;
+			uint32_t inputIdx;
+			// Gate that the gate's own node is only needed through, or UINT32_MAX.
+			uint32_t parent = UINT32_MAX;
+			uint32_t depth = 0;
+			// Set if the branch contains a node that needs continuous evaluation.
+			bool alwaysOpen = false;
+		};
+
+		struct BatchEntry
+		{
+			InstanceData* graphInst;
+			PoseCache* poseCache;
+			// Set by EvaluateBatch to the instance's output pose.
+			std::span<ozz::math::SoaTransform> output;
+		};
+
+		struct NodeCost
+		{
+			// UINT64_MAX when the entry aggregates every node of a type.
+			uint64_t nodeIdx = UINT64_MAX;
+			std::string_view typeName;
+			uint64_t nodeCount = 0;
+			uint64_t evaluateCalls = 0;
+			double evaluateMs = 0.0;
+			uint64_t advanceCalls = 0;
+			double advanceMs = 0.0;
+			uint64_t posesAcquired = 0;
+		};
+
 		std::vector<std::unique_ptr<PNode>> nodes;
 		uint64_t actorNode = 0;
 		uint64_t loopTrackingNode = 0;
+		// Peak number of poses alive at once while evaluating the graph.
+		size_t numPoseSlots = 0;
+		// Number of result slots in each of PResultBuffers' buffers.
+		std::array<uint32_t, PResultBuffers::kBufferCount> resultCounts{};
 		bool needsRestPose = false;
 		bool needsPhysSystem = false;
+		// One zone per node, only recorded while Util::Profiler::IsDetailedEnabled is set.
+		std::vector<Util::Profiler::ZoneID> nodeZones;
+		// Offset of each node's instance data in an instance's arena, or UINT64_MAX if the node has none.
+		std::vector<size_t> instanceOffsets;
+		size_t instanceArenaSize = 0;
+		size_t instanceArenaAlignment = alignof(std::max_align_t);
+		// Variable names and node indexes, sorted by name.
+		std::vector<std::pair<std::string_view, size_t>> variableNodes;
+		// Nodes in evaluation order, with their evaluate functions resolved ahead of time and some common chains fused.
+		std::vector<PPlanStep> plan;
+		// One gate per conditional input. The nodes only reachable through a closed gate are skipped that frame.
+		std::vector<BranchGate> branchGates;
+		// Set by the graph file to opt in to evaluating independent branches on separate threads.
+		bool parallelEvaluation = false;
+		// Set by the graph file to opt in to skipping branches that don't contribute to the output. See branchGates.
+		bool branchPruning = false;
+		// Ranges of plan steps that run side by side, or empty if the graph is evaluated serially.
+		std::vector<std::pair<uint32_t, uint32_t>> parallelBranches;
 		
 		std::span<ozz::math::SoaTransform> Evaluate(InstanceData& a_graphInst, PoseCache& a_poseCache);
+		// Evaluates several instances of the graph in lockstep, one plan step at a time for every instance, which lets
+		// value nodes process four instances at once. Graphs with parallel branches and instances with node stats enabled
+		// are evaluated one instance at a time. Only the benchmarks call this for now, since each actor's graph is updated
+		// from its own engine update hook and GraphManager never sees the instances of a graph together.
+		void EvaluateBatch(std::span<BatchEntry> a_batch);
+		// Releases every pose the instance acquired from the cache passed to Evaluate, pose slots included, so the span
+		// Evaluate returned is invalid afterwards.
+		void ReleasePoses(InstanceData& a_graphInst);
 		bool AdvanceTime(InstanceData& a_graphInst, float a_deltaTime);
 		void Synchronize(InstanceData& a_graphInst, InstanceData& a_ownerInst, PGraph* a_ownerGraph, float a_correctionDelta);
 		void InitInstanceData(InstanceData& a_graphInst);
+		void SetNodeStatsEnabled(InstanceData& a_graphInst, bool a_enabled);
+		void SetBranchPruningEnabled(InstanceData& a_graphInst, bool a_enabled);
+		std::vector<NodeCost> GetNodeCostReport(const InstanceData& a_graphInst, bool a_byType) const;
 		virtual std::unique_ptr<Generator> CreateGenerator() override;
 		virtual size_t GetSizeBytes();
 
 	protected:
 		friend class Serialization::BlendGraphImport;
 
+		// Folds constant value and vector subgraphs into fixed nodes, skips blends with a constant weight that selects a
+		// single input, and removes the nodes left unused. Must be called while inputs are still pointers. Returns the
+		// net number of nodes removed, after the fixed nodes it adds.
+		size_t FoldConstants();
 		bool SortNodes(std::vector<PNode*>& a_sortedNodes);
-		void InsertCacheReleaseNodes(std::vector<PNode*>& a_sortedNodes);
+		void AllocatePoseSlots(std::vector<PNode*>& a_sortedNodes);
 		void PointersToIndexes(std::vector<PNode*>& a_sortedNodes);
 		void EmplaceNodeOrder(std::vector<PNode*>& a_sortedNodes);
+		void AssignResultSlots();
+		std::vector<uint32_t> BuildBranchGates();
+		void BuildPlan();
+		void BuildParallelBranches();
+		void LayoutInstanceData();
 
 	private:
+		void BeginEvaluate(InstanceData& a_graphInst, PoseCache& a_poseCache);
+		void EvaluateParallel(InstanceData& a_graphInst, PoseCache& a_poseCache, PNodeStats* a_stats);
+		void RunStep(const PPlanStep& a_step, PoseCache& a_poseCache, InstanceData& a_graphInst, PNodeStats* a_stats);
+		bool IsGateOpen(uint32_t a_gate, InstanceData& a_graphInst);
 		bool DepthFirstNodeSort(PNode* a_node, size_t a_depth, std::unordered_set<PNode*>& a_visited, std::unordered_set<PNode*>& a_recursionStack, std::vector<PNode*>& a_sortedNodes);
+		bool IsConstantNode(PNode* a_node, const PNode::Registration* a_fixedValType, const PNode::Registration* a_fixedVecType, std::unordered_map<PNode*, bool>& a_constants);
+		// Assigns scratch result slots to a constant node and its inputs, and appends them to a_evalOrder inputs first.
+		void CollectConstantNode(PNode* a_node, std::array<uint32_t, PResultBuffers::kBufferCount>& a_counts, std::vector<PNode*>& a_evalOrder);
 	};
 }
\ No newline at end of file
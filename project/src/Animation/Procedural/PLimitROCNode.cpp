@@ -1,16 +1,17 @@
 #include "PLimitROCNode.h"
+#include "PBatch.h"
 
 namespace Animation::Procedural
 {
-	std::unique_ptr<PNodeInstanceData> PLimitROCNode::CreateInstanceData()
+	PNodeInstanceData* PLimitROCNode::CreateInstanceData(void* a_memory)
 	{
-		return std::make_unique<InstanceData>();
+		return new (a_memory) InstanceData();
 	}
 
-	PEvaluationResult PLimitROCNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	float PLimitROCNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
 		auto inst = static_cast<InstanceData*>(a_instanceData);
-		float value = std::get<float>(a_evalContext.results[inputs[0]]);
+		float value = GetRequiredInput<float>(0, a_evalContext);
 
 		if (!inst->initialized) {
 			inst->initialized = true;
@@ -26,11 +27,43 @@ namespace Animation::Procedural
 		return result;
 	}
 
+	PEvaluateBatchFunc PLimitROCNode::GetEvaluateBatchFunc()
+	{
+		return &EvaluateBatch;
+	}
+
+	void PLimitROCNode::EvaluateBatch(const PPlanStep& a_step, std::span<PEvaluationContext* const> a_evalContexts)
+	{
+		using namespace ozz::math;
+		auto node = static_cast<PLimitROCNode*>(a_step.node);
+		const SimdFloat4 rate = simd_float4::Load1(node->rateOfChange);
+		ForEachBatchGroup(a_evalContexts, [&](const PBatchGroup& a_group) {
+			auto insts = GetBatchInstances<InstanceData>(a_group, a_step.nodeIdx);
+			const SimdFloat4 value = GatherFloats(a_group, node->inputSlots[0]);
+			const SimdFloat4 previous = GatherFloats(insts, &InstanceData::previousValue);
+			const SimdFloat4 maxChange = rate * GatherFloats(insts, &InstanceData::timeStep);
+			const SimdFloat4 limitedChange = Clamp(simd_float4::zero() - maxChange, value - previous, maxChange);
+			const SimdInt4 initialized = GatherMask(insts, [](InstanceData* a_inst) { return a_inst->initialized; });
+			const SimdFloat4 result = Select(initialized, previous + limitedChange, value);
+
+			ScatterFloats(insts, &InstanceData::previousValue, result);
+			for (auto inst : insts) {
+				inst->initialized = true;
+			}
+			ScatterFloats(a_group, node->resultSlot, result);
+		});
+	}
+
 	void PLimitROCNode::AdvanceTime(PNodeInstanceData* a_instanceData, float a_deltaTime)
 	{
 		static_cast<InstanceData*>(a_instanceData)->timeStep = a_deltaTime;
 	}
 
+	bool PLimitROCNode::NeedsContinuousEvaluation()
+	{
+		return true;
+	}
+
 	bool PLimitROCNode::SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir)
 	{
 		rateOfChange = std::max(std::get<float>(a_values[0]), 0.0f);
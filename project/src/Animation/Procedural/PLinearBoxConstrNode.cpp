@@ -9,12 +9,12 @@ namespace Animation::Procedural
 		return this;
 	}
 
-	std::unique_ptr<PNodeInstanceData> PLinearBoxConstrNode::CreateInstanceData()
+	PNodeInstanceData* PLinearBoxConstrNode::CreateInstanceData(void* a_memory)
 	{
-		return std::make_unique<InstanceData>();
+		return new (a_memory) InstanceData();
 	}
 
-	PEvaluationResult PLinearBoxConstrNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	PDataObject* PLinearBoxConstrNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
 		auto inst = static_cast<InstanceData*>(a_instanceData);
 		const Float4 min = GetRequiredInput<ozz::math::Float4>(0, a_evalContext);
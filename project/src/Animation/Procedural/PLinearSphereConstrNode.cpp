@@ -7,12 +7,12 @@ namespace Animation::Procedural
 		return this;
 	}
 
-	std::unique_ptr<PNodeInstanceData> PLinearSphereConstrNode::CreateInstanceData()
+	PNodeInstanceData* PLinearSphereConstrNode::CreateInstanceData(void* a_memory)
 	{
-		return std::make_unique<InstanceData>();
+		return new (a_memory) InstanceData();
 	}
 
-	PEvaluationResult PLinearSphereConstrNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	PDataObject* PLinearSphereConstrNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
 		auto inst = static_cast<InstanceData*>(a_instanceData);
 		inst->radius = GetRequiredInput<float>(0, a_evalContext);
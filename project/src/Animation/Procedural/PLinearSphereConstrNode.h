@@ -15,8 +15,8 @@ namespace Animation::Procedural
 			virtual Physics::LinearConstraint* IsLinearConstraint() override;
 		};
 
-		virtual std::unique_ptr<PNodeInstanceData> CreateInstanceData() override;
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override;
+		virtual PNodeInstanceData* CreateInstanceData(void* a_memory) override;
+		PDataObject* Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext);
 
 		inline static Registration _reg{
 			"linear_sphere_constr",
@@ -7,6 +7,73 @@ namespace Animation::Procedural
 		return 0;
 	}
 
+	PResultBuffers::BUFFER PResultBuffers::GetBuffer(size_t a_type)
+	{
+		switch (a_type) {
+		case PEvaluationType<float>:
+			return kFloat;
+		case PEvaluationType<ozz::math::Float4>:
+			return kVector;
+		case PEvaluationType<PoseCache::Handle>:
+			return kPose;
+		case PEvaluationType<PDataObject*>:
+			return kDataObject;
+		case PEvaluationType<bool>:
+			return kBool;
+		default:
+			return kOther;
+		}
+	}
+
+	void PResultBuffers::resize(const std::array<uint32_t, kBufferCount>& a_counts)
+	{
+		floats.resize(a_counts[kFloat]);
+		vectors.resize(a_counts[kVector]);
+		poses.resize(a_counts[kPose]);
+		dataObjects.resize(a_counts[kDataObject]);
+		bools.resize(a_counts[kBool]);
+		others.resize(a_counts[kOther]);
+	}
+
+	size_t PResultBuffers::heap_bytes() const
+	{
+		return Util::Memory::GetHeapBytes(floats) + Util::Memory::GetHeapBytes(vectors) + Util::Memory::GetHeapBytes(poses) +
+		       Util::Memory::GetHeapBytes(dataObjects) + Util::Memory::GetHeapBytes(bools) + Util::Memory::GetHeapBytes(others);
+	}
+
+	PInstanceArena::~PInstanceArena()
+	{
+		for (auto iter = _objects.rbegin(); iter != _objects.rend(); iter++) {
+			(*iter)->~PNodeInstanceData();
+		}
+		if (_data) {
+			::operator delete(_data, std::align_val_t{ _alignment });
+		}
+	}
+
+	void PInstanceArena::allocate(size_t a_size, size_t a_alignment)
+	{
+		_size = a_size;
+		_alignment = a_alignment;
+		if (a_size > 0) {
+			_data = static_cast<std::byte*>(::operator new(a_size, std::align_val_t{ a_alignment }));
+		}
+	}
+
+	PNodeInstanceData* PInstanceArena::create(PNode* a_node, size_t a_offset)
+	{
+		PNodeInstanceData* result = a_node->CreateInstanceData(_data + a_offset);
+		if (result) {
+			_objects.push_back(result);
+		}
+		return result;
+	}
+
+	size_t PInstanceArena::size() const
+	{
+		return _size;
+	}
+
 	void PEvaluationContext::UpdateModelSpaceCache(const std::span<ozz::math::SoaTransform>& a_localPose, int a_from, int a_to)
 	{
 		ozz::animation::LocalToModelJob l2mJob;
@@ -18,10 +85,23 @@ namespace Animation::Procedural
 		l2mJob.Run();
 	}
 
+	std::pair<std::string_view, PVariableInstance*>* PEvaluationContext::FindVariable(std::string_view a_name)
+	{
+		auto iter = std::lower_bound(variables.begin(), variables.end(), a_name, [](const auto& a_entry, std::string_view a_name) {
+			return a_entry.first < a_name;
+		});
+		if (iter != variables.end() && iter->first == a_name) {
+			return std::addressof(*iter);
+		}
+		return nullptr;
+	}
+
 	size_t PEvaluationContext::GetSizeBytes() const
 	{
-		size_t result = sizeof(PEvaluationContext) + std::span(nodeInstances).size_bytes() +
-		                std::span(results).size_bytes() + std::span(syncMap).size_bytes();
+		size_t result = sizeof(PEvaluationContext) + Util::Memory::GetHeapBytes(nodeInstances) +
+		                results.heap_bytes() + Util::Memory::GetHeapBytes(syncMap) +
+		                Util::Memory::GetHeapBytes(nodeStats) + Util::Memory::GetHeapBytes(gateStates) + Util::Memory::GetHeapBytes(variables) +
+		                Util::Memory::GetHeapBytes(poseSlots) + Util::Memory::GetHeapBytes(branchPoseCaches);
 
 		for (auto& inst : nodeInstances) {
 			if (inst) {
@@ -29,10 +109,19 @@ namespace Animation::Procedural
 			}
 		}
 
+		for (auto& c : branchPoseCaches) {
+			result += sizeof(PoseCache) + c->heap_bytes();
+		}
+
 		return result;
 	}
 
-	std::unique_ptr<PNodeInstanceData> PNode::CreateInstanceData()
+	PNode::InstanceLayout PNode::GetInstanceLayout()
+	{
+		return {};
+	}
+
+	PNodeInstanceData* PNode::CreateInstanceData(void* a_memory)
 	{
 		return nullptr;
 	}
@@ -55,6 +144,36 @@ namespace Animation::Procedural
 		return nullptr;
 	}
 
+	PEvaluateBatchFunc PNode::GetEvaluateBatchFunc()
+	{
+		return nullptr;
+	}
+
+	uint32_t PNode::GetModifiedPoseInputs()
+	{
+		return 0;
+	}
+
+	uint32_t PNode::GetConditionalInputs()
+	{
+		return 0;
+	}
+
+	uint32_t PNode::GetSkippedInputs(PEvaluationContext& a_evalContext)
+	{
+		return 0;
+	}
+
+	bool PNode::NeedsContinuousEvaluation()
+	{
+		return false;
+	}
+
+	bool PNode::CanEvaluateInParallel()
+	{
+		return true;
+	}
+
 	size_t PNode::GetSizeBytes()
 	{
 		return 0;
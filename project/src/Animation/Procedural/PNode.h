@@ -34,6 +34,103 @@ namespace Animation::Procedural
 		}
 	};
 
+	// Holds the instance data of every node of a graph instance in one allocation, at offsets computed by
+	// PGraph::LayoutInstanceData.
+	class PInstanceArena
+	{
+	public:
+		PInstanceArena() = default;
+		PInstanceArena(const PInstanceArena&) = delete;
+		PInstanceArena& operator=(const PInstanceArena&) = delete;
+		~PInstanceArena();
+
+		void allocate(size_t a_size, size_t a_alignment);
+		// Constructs a_node's instance data at a_offset. It's destroyed along with the arena.
+		PNodeInstanceData* create(PNode* a_node, size_t a_offset);
+		size_t size() const;
+
+	private:
+		std::byte* _data = nullptr;
+		size_t _size = 0;
+		size_t _alignment = 0;
+		std::vector<PNodeInstanceData*> _objects;
+	};
+
+	// Node results, with one buffer per common result type. Slots are assigned by PGraph::AssignResultSlots, so nodes read
+	// their inputs straight from the typed buffers.
+	struct PResultBuffers
+	{
+		struct BoolSlot
+		{
+			bool value = false;
+		};
+
+		enum BUFFER : uint8_t
+		{
+			kFloat = 0,
+			kVector = 1,
+			kPose = 2,
+			kDataObject = 3,
+			kBool = 4,
+			kOther = 5,
+
+			kBufferCount
+		};
+
+		std::vector<float> floats;
+		std::vector<ozz::math::Float4> vectors;
+		std::vector<PoseCache::Handle> poses;
+		std::vector<PDataObject*> dataObjects;
+		// Wrapped so the buffer isn't a packed std::vector<bool>, which can't hand out references to its elements.
+		std::vector<BoolSlot> bools;
+		// Results of any other type.
+		std::vector<PEvaluationResult> others;
+
+		template <typename T>
+		inline T& get(uint32_t a_slot)
+		{
+			if constexpr (std::is_same_v<T, float>) {
+				return floats[a_slot];
+			} else if constexpr (std::is_same_v<T, ozz::math::Float4>) {
+				return vectors[a_slot];
+			} else if constexpr (std::is_same_v<T, PoseCache::Handle>) {
+				return poses[a_slot];
+			} else if constexpr (std::is_same_v<T, PDataObject*>) {
+				return dataObjects[a_slot];
+			} else if constexpr (std::is_same_v<T, bool>) {
+				return bools[a_slot].value;
+			} else {
+				return std::get<T>(others[a_slot]);
+			}
+		}
+
+		// Writes a node's output to its slot. Types without a buffer of their own go to others.
+		template <typename T>
+		inline void set(uint32_t a_slot, T&& a_value)
+		{
+			using V = std::remove_cvref_t<T>;
+			if constexpr (std::is_same_v<V, float> || std::is_same_v<V, ozz::math::Float4> || std::is_same_v<V, PoseCache::Handle> ||
+						  std::is_same_v<V, PDataObject*> || std::is_same_v<V, bool>) {
+				get<V>(a_slot) = std::forward<T>(a_value);
+			} else {
+				others[a_slot] = std::forward<T>(a_value);
+			}
+		}
+
+		static BUFFER GetBuffer(size_t a_type);
+		void resize(const std::array<uint32_t, kBufferCount>& a_counts);
+		size_t heap_bytes() const;
+	};
+
+	struct PNodeStats
+	{
+		uint64_t evaluateCalls = 0;
+		uint64_t evaluateTicks = 0;
+		uint64_t advanceCalls = 0;
+		uint64_t advanceTicks = 0;
+		uint64_t posesAcquired = 0;
+	};
+
 	struct PEvaluationContext
 	{
 		struct SyncData
@@ -43,11 +140,27 @@ namespace Animation::Procedural
 			PNodeInstanceData* ownerInstData;
 		};
 
-		std::vector<std::unique_ptr<PNodeInstanceData>> nodeInstances;
-		std::vector<PEvaluationResult> results;
-		std::unordered_map<std::string_view, PVariableInstance*> variableMap;
+		PInstanceArena instanceArena;
+		// Points into instanceArena, or nullptr for nodes without instance data.
+		std::vector<PNodeInstanceData*> nodeInstances;
+		// One pose cache per parallel branch of the graph, so a cache is never used from two threads at once. Declared
+		// before results, so the handles results holds into these caches are released before the caches are destroyed.
+		std::vector<std::unique_ptr<PoseCache>> branchPoseCaches;
+		PResultBuffers results;
+		// Sorted by name.
+		std::vector<std::pair<std::string_view, PVariableInstance*>> variables;
 		PEvaluationContext* lastSyncOwner = nullptr;
 		std::vector<SyncData> syncMap;
+		// One pose per slot assigned by PGraph::AllocatePoseSlots. Acquired from the cache passed to each Evaluate, and
+		// released by PGraph::ReleasePoses.
+		std::vector<PoseCache::Handle> poseSlots;
+		// Only populated while node stats are enabled for this instance.
+		std::vector<PNodeStats> nodeStats;
+		// Skip branches that don't contribute to the output this frame. See PGraph::branchGates. Set from
+		// PGraph::branchPruning, and can be changed per instance with PGraph::SetBranchPruningEnabled.
+		bool pruneBranches = false;
+		// Per-frame state of each of the graph's branch gates.
+		std::vector<uint8_t> gateStates;
 
 		PoseCache::Handle* restPose = nullptr;
 		const ozz::animation::Skeleton* skeleton = nullptr;
@@ -58,9 +171,32 @@ namespace Animation::Procedural
 			int a_from = ozz::animation::Skeleton::kNoParent,
 			int a_to = ozz::animation::Skeleton::kMaxJoints);
 
+		// Returns nullptr if there is no variable named a_name. Names are lowercase.
+		std::pair<std::string_view, PVariableInstance*>* FindVariable(std::string_view a_name);
 		size_t GetSizeBytes() const;
 	};
 
+	struct PPlanStep;
+	// Evaluates one step of a graph's plan and writes the result to the context's result buffers.
+	using PEvaluateFunc = void (*)(const PPlanStep& a_step, PoseCache& a_poseCache, PEvaluationContext& a_evalContext);
+	// Evaluates one step of a graph's plan for several instances of the graph at once.
+	using PEvaluateBatchFunc = void (*)(const PPlanStep& a_step, std::span<PEvaluationContext* const> a_evalContexts);
+
+	struct PPlanStep
+	{
+		PEvaluateFunc func;
+		PNode* node;
+		uint32_t nodeIdx;
+		// Nodes folded into a fused step, in reverse evaluation order. Their results are never written, so each one
+		// must only feed the next node of the step.
+		std::array<PNode*, 2> fusedNodes{};
+		std::array<uint32_t, 2> fusedIdxs{ UINT32_MAX, UINT32_MAX };
+		// Innermost branch gate the step is only needed through, or UINT32_MAX if it always runs.
+		uint32_t gate = UINT32_MAX;
+		// Set if the step can be evaluated for a whole batch of instances in one call. See PGraph::EvaluateBatch.
+		PEvaluateBatchFunc batchFunc = nullptr;
+	};
+
 	class PNode
 	{
 	public:
@@ -111,15 +247,50 @@ namespace Animation::Procedural
 			const char* outputDisplayName;
 		};
 
+		struct InstanceLayout
+		{
+			size_t size = 0;
+			size_t alignment = 1;
+		};
+
 		uint64_t syncId = UINT64_MAX;
 		std::vector<uint64_t> inputs;
+		// Result slot of each input, or UINT32_MAX for unconnected optional inputs.
+		std::vector<uint32_t> inputSlots;
+		// Index of this node's output in the result buffer of its output type.
+		uint32_t resultSlot = UINT32_MAX;
+		size_t resultType = 0;
+		// Pose slot this node writes its output to, or UINT16_MAX if it doesn't output a pose.
+		uint16_t poseSlot = UINT16_MAX;
+		// Bit N is set if this node's output shares input N's pose slot, so the node modifies that pose in place.
+		uint32_t inPlaceInputs = 0;
 
-		virtual std::unique_ptr<PNodeInstanceData> CreateInstanceData();
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) = 0;
+		// Size and alignment of the instance data built by CreateInstanceData, or a size of 0 if the node has none.
+		virtual InstanceLayout GetInstanceLayout();
+		// Constructs the node's instance data in a_memory, which is laid out according to GetInstanceLayout.
+		virtual PNodeInstanceData* CreateInstanceData(void* a_memory);
 		virtual void AdvanceTime(PNodeInstanceData* a_instanceData, float a_deltaTime);
 		virtual void Synchronize(PNodeInstanceData* a_instanceData, PNodeInstanceData* a_ownerInstance, float a_correctionDelta);
 		virtual bool SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir);
 		virtual Registration* GetTypeInfo();
+		// Returns the function a graph's plan uses to evaluate this node. Nodes implement a non-virtual Evaluate that returns
+		// their output type, which PNodeT builds this function from.
+		virtual PEvaluateFunc GetEvaluateFunc() = 0;
+		// Returns the function PGraph::EvaluateBatch uses to evaluate this node for several instances at once, or nullptr
+		// if each instance is evaluated on its own.
+		virtual PEvaluateBatchFunc GetEvaluateBatchFunc();
+		// Bitmask of pose inputs this node only makes small changes to, which lets its output reuse the input's slot when
+		// nothing reads the input afterwards. Such nodes must get their output through GetModifiablePose.
+		virtual uint32_t GetModifiedPoseInputs();
+		// Bitmask of inputs this node doesn't read on some frames. They are sorted after the node's other inputs, so those
+		// are already evaluated by the time GetSkippedInputs is called.
+		virtual uint32_t GetConditionalInputs();
+		// Bitmask of conditional inputs this node won't read this frame. Evaluate must agree with it.
+		virtual uint32_t GetSkippedInputs(PEvaluationContext& a_evalContext);
+		// True if the node keeps state between Evaluate calls, in which case the branches it's in are never skipped.
+		virtual bool NeedsContinuousEvaluation();
+		// False if Evaluate uses state shared by the whole instance, such as the model space cache or physics system.
+		virtual bool CanEvaluateInParallel();
 		virtual size_t GetSizeBytes();
 		virtual ~PNode() = default;
 
@@ -133,20 +304,43 @@ namespace Animation::Procedural
 		template <typename T>
 		inline T& GetRequiredInput(size_t a_idx, PEvaluationContext& a_evalContext)
 		{
-			return std::get<T>(a_evalContext.results[inputs[a_idx]]);
+			return a_evalContext.results.get<T>(inputSlots[a_idx]);
 		}
 
 		template <typename T>
 		inline T GetOptionalInput(size_t a_idx, const T& a_default, PEvaluationContext& a_evalContext)
 		{
-			size_t resIdx = inputs[a_idx];
-			if (resIdx == UINT64_MAX) {
+			if (inputSlots[a_idx] == UINT32_MAX) {
 				return a_default;
 			} else {
 				return GetRequiredInput<T>(a_idx, a_evalContext);
 			}
 		}
 
+		inline PoseCache::Handle AcquireOutputPose(PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+		{
+			if (poseSlot < a_evalContext.poseSlots.size()) {
+				return a_evalContext.poseSlots[poseSlot].borrow();
+			} else {
+				return a_poseCache.acquire_handle();
+			}
+		}
+
+		// Returns the pose from input a_idx in this node's output handle. The pose is only copied if the output doesn't
+		// share the input's slot.
+		inline PoseCache::Handle GetModifiablePose(size_t a_idx, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+		{
+			PoseCache::Handle& input = GetRequiredInput<PoseCache::Handle>(a_idx, a_evalContext);
+			if (inPlaceInputs & (1u << a_idx)) {
+				return input.borrow();
+			}
+
+			PoseCache::Handle output = AcquireOutputPose(a_poseCache, a_evalContext);
+			auto inputSpan = input.get();
+			std::copy(inputSpan.begin(), inputSpan.end(), output.get().begin());
+			return output;
+		}
+
 		inline size_t GetVariadicInputCount()
 		{
 			throw std::runtime_error("unimplemented");
@@ -170,10 +364,32 @@ namespace Animation::Procedural
 			return &T::_reg;
 		}
 
+		virtual PEvaluateFunc GetEvaluateFunc() override
+		{
+			return &EvaluateStepT;
+		}
+
+		virtual InstanceLayout GetInstanceLayout() override
+		{
+			if constexpr (requires { typename T::InstanceData; }) {
+				return { sizeof(typename T::InstanceData), alignof(typename T::InstanceData) };
+			} else {
+				return {};
+			}
+		}
+
 		virtual size_t GetSizeBytes() override
 		{
 			return sizeof(T);
 		}
+
+	private:
+		// Calls T::Evaluate directly and stores its output straight into the buffer for the type it returns.
+		static void EvaluateStepT(const PPlanStep& a_step, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+		{
+			auto node = static_cast<T*>(a_step.node);
+			a_evalContext.results.set(node->resultSlot, node->T::Evaluate(a_evalContext.nodeInstances[a_step.nodeIdx], a_poseCache, a_evalContext));
+		}
 	};
 
 	template <typename T>
@@ -6,18 +6,15 @@
 
 namespace Animation::Procedural
 {
-	PEvaluationResult POneBoneIKNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	PoseCache::Handle POneBoneIKNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
 		// Get node input data.
-		PoseCache::Handle& input = std::get<PoseCache::Handle>(a_evalContext.results[inputs[0]]);
-		const ozz::math::Float4& target = std::get<ozz::math::Float4>(a_evalContext.results[inputs[1]]);
-		const ozz::math::Float4& offset = std::get<ozz::math::Float4>(a_evalContext.results[inputs[2]]);
+		const ozz::math::Float4& target = GetRequiredInput<ozz::math::Float4>(1, a_evalContext);
+		const ozz::math::Float4& offset = GetRequiredInput<ozz::math::Float4>(2, a_evalContext);
 
-		// Acquire a pose handle for this node's output and copy the input pose to the output pose - we only need to make 1 correction to the pose.
-		PoseCache::Handle output = a_poseCache.acquire_handle();
-		auto inputSpan = input.get();
+		// Get the input pose as this node's output - we only need to make 1 correction to the pose.
+		PoseCache::Handle output = GetModifiablePose(0, a_poseCache, a_evalContext);
 		auto outputSpan = output.get();
-		std::copy(inputSpan.begin(), inputSpan.end(), outputSpan.begin());
 
 		// Update model space transforms.
 		a_evalContext.UpdateModelSpaceCache(outputSpan, ozz::animation::Skeleton::kNoParent, boneIdx);
@@ -43,6 +40,16 @@ namespace Animation::Procedural
 		return output;
 	}
 
+	uint32_t POneBoneIKNode::GetModifiedPoseInputs()
+	{
+		return 1;
+	}
+
+	bool POneBoneIKNode::CanEvaluateInParallel()
+	{
+		return false;
+	}
+
 	bool POneBoneIKNode::SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir)
 	{
 		const RE::BSFixedString boneName = std::get<RE::BSFixedString>(a_values[0]);
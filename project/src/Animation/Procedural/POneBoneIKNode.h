@@ -10,7 +10,9 @@ namespace Animation::Procedural
 		ozz::math::Float3 forwardAxis;
 		ozz::math::Float3 upAxis;
 
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override;
+		PoseCache::Handle Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext);
+		virtual uint32_t GetModifiedPoseInputs() override;
+		virtual bool CanEvaluateInParallel() override;
 		virtual bool SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir) override;
 
 		inline static Registration _reg{
@@ -2,32 +2,55 @@
 
 namespace Animation::Procedural
 {
-	std::unique_ptr<PNodeInstanceData> PSmoothValNode::CreateInstanceData()
+	PNodeInstanceData* PSmoothValNode::CreateInstanceData(void* a_memory)
 	{
-		return std::make_unique<InstanceData>();
+		return new (a_memory) InstanceData();
 	}
 
-	PEvaluationResult PSmoothValNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	float PSmoothValNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
-		auto inst = static_cast<InstanceData*>(a_instanceData);
-		float value = std::get<float>(a_evalContext.results[inputs[0]]);
+		return Apply(static_cast<InstanceData*>(a_instanceData), GetRequiredInput<float>(0, a_evalContext));
+	}
+
+	ozz::math::SimdFloat4 PSmoothValNode::Apply(const PBatchInstances<InstanceData>& a_insts, ozz::math::_SimdFloat4 a_values) const
+	{
+		using namespace ozz::math;
+		const SimdFloat4 previous = GatherFloats(a_insts, &InstanceData::previousValue);
+		const SimdFloat4 t = GatherFloats(a_insts, &InstanceData::timeStep) * simd_float4::Load1(percentPerSec);
+		const SimdInt4 initialized = GatherMask(a_insts, [](InstanceData* a_inst) { return a_inst->initialized; });
+		const SimdFloat4 result = Select(initialized, MAdd(a_values - previous, t, previous), a_values);
 
-		if (!inst->initialized) {
+		ScatterFloats(a_insts, &InstanceData::previousValue, result);
+		for (auto inst : a_insts) {
 			inst->initialized = true;
-			inst->previousValue = value;
-			return value;
 		}
-
-		float result = std::lerp(inst->previousValue, value, percentPerSec * inst->timeStep);
-		inst->previousValue = result;
 		return result;
 	}
 
+	PEvaluateBatchFunc PSmoothValNode::GetEvaluateBatchFunc()
+	{
+		return &EvaluateBatch;
+	}
+
+	void PSmoothValNode::EvaluateBatch(const PPlanStep& a_step, std::span<PEvaluationContext* const> a_evalContexts)
+	{
+		auto node = static_cast<PSmoothValNode*>(a_step.node);
+		ForEachBatchGroup(a_evalContexts, [&](const PBatchGroup& a_group) {
+			auto insts = GetBatchInstances<InstanceData>(a_group, a_step.nodeIdx);
+			ScatterFloats(a_group, node->resultSlot, node->Apply(insts, GatherFloats(a_group, node->inputSlots[0])));
+		});
+	}
+
 	void PSmoothValNode::AdvanceTime(PNodeInstanceData* a_instanceData, float a_deltaTime)
 	{
 		static_cast<InstanceData*>(a_instanceData)->timeStep = a_deltaTime;
 	}
 
+	bool PSmoothValNode::NeedsContinuousEvaluation()
+	{
+		return true;
+	}
+
 	bool PSmoothValNode::SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir)
 	{
 		percentPerSec = std::clamp(std::get<float>(a_values[0]), 0.0f, 1.0f);
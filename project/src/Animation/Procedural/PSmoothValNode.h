@@ -1,5 +1,6 @@
 #pragma once
 #include "PNode.h"
+#include "PBatch.h"
 
 namespace Animation::Procedural
 {
@@ -15,10 +16,28 @@ namespace Animation::Procedural
 
 		float percentPerSec;
 
-		virtual std::unique_ptr<PNodeInstanceData> CreateInstanceData() override;
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override;
+		inline float Apply(InstanceData* a_inst, float a_value) const
+		{
+			if (!a_inst->initialized) {
+				a_inst->initialized = true;
+				a_inst->previousValue = a_value;
+				return a_value;
+			}
+
+			a_inst->previousValue = std::lerp(a_inst->previousValue, a_value, percentPerSec * a_inst->timeStep);
+			return a_inst->previousValue;
+		}
+
+		// Applies the smoothing to four instances at once, one per lane.
+		ozz::math::SimdFloat4 Apply(const PBatchInstances<InstanceData>& a_insts, ozz::math::_SimdFloat4 a_values) const;
+
+		virtual PNodeInstanceData* CreateInstanceData(void* a_memory) override;
+		float Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext);
+		virtual PEvaluateBatchFunc GetEvaluateBatchFunc() override;
 		virtual void AdvanceTime(PNodeInstanceData* a_instanceData, float a_deltaTime) override;
+		virtual bool NeedsContinuousEvaluation() override;
 		virtual bool SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir) override;
+		static void EvaluateBatch(const PPlanStep& a_step, std::span<PEvaluationContext* const> a_evalContexts);
 
 		inline static Registration _reg{
 			"smooth_val",
@@ -1,15 +1,16 @@
 #include "PSmoothedRandNode.h"
 #include "Util/General.h"
 #include "Animation/Easing.h"
+#include "PBatch.h"
 
 namespace Animation::Procedural
 {
-	std::unique_ptr<PNodeInstanceData> PSmoothedRandNode::CreateInstanceData()
+	PNodeInstanceData* PSmoothedRandNode::CreateInstanceData(void* a_memory)
 	{
-		return std::make_unique<InstanceData>();
+		return new (a_memory) InstanceData();
 	}
 
-	PEvaluationResult PSmoothedRandNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	float PSmoothedRandNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
 		auto inst = static_cast<InstanceData*>(a_instanceData);
 		if (inst->state == RandState::kTransitioning) {
@@ -20,6 +21,32 @@ namespace Animation::Procedural
 		}
 	}
 
+	PEvaluateBatchFunc PSmoothedRandNode::GetEvaluateBatchFunc()
+	{
+		return &EvaluateBatch;
+	}
+
+	void PSmoothedRandNode::EvaluateBatch(const PPlanStep& a_step, std::span<PEvaluationContext* const> a_evalContexts)
+	{
+		using namespace ozz::math;
+		const uint32_t slot = a_step.node->resultSlot;
+		const SimdFloat4 half = simd_float4::Load1(0.5f);
+		const SimdFloat4 two = simd_float4::Load1(2.0f);
+		const SimdFloat4 four = simd_float4::Load1(4.0f);
+		ForEachBatchGroup(a_evalContexts, [&](const PBatchGroup& a_group) {
+			auto insts = GetBatchInstances<InstanceData>(a_group, a_step.nodeIdx);
+			const SimdFloat4 start = GatherFloats(insts, &InstanceData::startValue);
+			const SimdFloat4 target = GatherFloats(insts, &InstanceData::targetValue);
+			const SimdFloat4 x = GatherFloats(insts, &InstanceData::localTime) / GatherFloats(insts, &InstanceData::duration);
+
+			// Same curve as Animation::CubicInOutEase.
+			const SimdFloat4 y = two - two * x;
+			const SimdFloat4 ease = Select(CmpLt(x, half), four * x * x * x, simd_float4::one() - y * y * y * half);
+			const SimdInt4 transitioning = GatherMask(insts, [](InstanceData* a_inst) { return a_inst->state == RandState::kTransitioning; });
+			ScatterFloats(a_group, slot, Select(transitioning, MAdd(target - start, ease, start), target));
+		});
+	}
+
 	void PSmoothedRandNode::AdvanceTime(PNodeInstanceData* a_instanceData, float a_deltaTime)
 	{
 		auto inst = static_cast<InstanceData*>(a_instanceData);
@@ -29,12 +29,14 @@ namespace Animation::Procedural
 		float delayMax;
 		float edgeThreshold;
 
-		virtual std::unique_ptr<PNodeInstanceData> CreateInstanceData() override;
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override;
+		virtual PNodeInstanceData* CreateInstanceData(void* a_memory) override;
+		float Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext);
+		virtual PEvaluateBatchFunc GetEvaluateBatchFunc() override;
 		virtual void AdvanceTime(PNodeInstanceData* a_instanceData, float a_deltaTime) override;
 		virtual void Synchronize(PNodeInstanceData* a_instanceData, PNodeInstanceData* a_ownerInstance, float a_correctionDelta) override;
 		virtual bool SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir) override;
 		void UpdateTargetValue(InstanceData* a_instanceData);
+		static void EvaluateBatch(const PPlanStep& a_step, std::span<PEvaluationContext* const> a_evalContexts);
 
 		inline static Registration _reg{
 			"smooth_rand",
@@ -7,19 +7,17 @@
 
 namespace Animation::Procedural
 {
-	std::unique_ptr<PNodeInstanceData> PSpringBoneNode::CreateInstanceData()
+	PNodeInstanceData* PSpringBoneNode::CreateInstanceData(void* a_memory)
 	{
-		return std::make_unique<InstanceData>();
+		return new (a_memory) InstanceData();
 	}
 
-	PEvaluationResult PSpringBoneNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	PoseCache::Handle PSpringBoneNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
 		using namespace ozz::math;
 		auto inst = static_cast<InstanceData*>(a_instanceData);
 
 		// Get node input data.
-		PoseCache::Handle& input = GetRequiredInput<PoseCache::Handle>(0, a_evalContext);
-
 		Physics::SpringWithBodyProperties* linearProps = nullptr;
 		if (auto data = GetOptionalInput<PDataObject*>(1, nullptr, a_evalContext); data) {
 			linearProps = data->IsSpringProperties();
@@ -40,11 +38,9 @@ namespace Animation::Procedural
 			angularConstraint = data->IsAngularConstraint();
 		}
 
-		// Acquire a pose handle for this node's output and copy the input pose to the output pose - we only need to make 1 correction to the pose.
-		PoseCache::Handle output = a_poseCache.acquire_handle();
-		auto inputSpan = input.get();
+		// Get the input pose as this node's output - we only need to make 1 correction to the pose.
+		PoseCache::Handle output = GetModifiablePose(0, a_poseCache, a_evalContext);
 		auto outputSpan = output.get();
-		std::copy(inputSpan.begin(), inputSpan.end(), outputSpan.begin());
 
 		// Update model-space cache.
 		a_evalContext.UpdateModelSpaceCache(outputSpan, ozz::animation::Skeleton::kNoParent, boneIdx);
@@ -83,6 +79,21 @@ namespace Animation::Procedural
 		return output;
 	}
 
+	uint32_t PSpringBoneNode::GetModifiedPoseInputs()
+	{
+		return 1;
+	}
+
+	bool PSpringBoneNode::CanEvaluateInParallel()
+	{
+		return false;
+	}
+
+	bool PSpringBoneNode::NeedsContinuousEvaluation()
+	{
+		return true;
+	}
+
 	bool PSpringBoneNode::SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir)
 	{
 		const RE::BSFixedString& boneName = std::get<RE::BSFixedString>(a_values[0]);
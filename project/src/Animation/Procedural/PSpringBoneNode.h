@@ -16,8 +16,11 @@ namespace Animation::Procedural
 		uint16_t boneIdx;
 		uint16_t parentIdx;
 
-		virtual std::unique_ptr<PNodeInstanceData> CreateInstanceData() override;
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override;
+		virtual PNodeInstanceData* CreateInstanceData(void* a_memory) override;
+		PoseCache::Handle Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext);
+		virtual uint32_t GetModifiedPoseInputs() override;
+		virtual bool CanEvaluateInParallel() override;
+		virtual bool NeedsContinuousEvaluation() override;
 		virtual bool SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir) override;
 
 		inline static Registration _reg{
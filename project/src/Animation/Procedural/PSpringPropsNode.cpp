@@ -7,14 +7,14 @@ namespace Animation::Procedural
 		return this;
 	}
 
-	std::unique_ptr<PNodeInstanceData> PSpringPropsNode::CreateInstanceData()
+	PNodeInstanceData* PSpringPropsNode::CreateInstanceData(void* a_memory)
 	{
-		auto result = std::make_unique<InstanceData>();
+		auto result = new (a_memory) InstanceData();
 		result->upAxis = ozz::math::simd_float4::Load3PtrU(&upAxis.x);
 		return result;
 	}
 
-	PEvaluationResult PSpringPropsNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	PDataObject* PSpringPropsNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
 		auto inst = static_cast<InstanceData*>(a_instanceData);
 		inst->spring.stiffness = std::clamp(GetRequiredInput<float>(0, a_evalContext), 1.0f, 10000.0f);
@@ -3,9 +3,9 @@
 
 namespace Animation::Procedural
 {
-	PEvaluationResult PStaticPoseNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	PoseCache::Handle PStaticPoseNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
-		PoseCache::Handle result = a_poseCache.acquire_handle();
+		PoseCache::Handle result = AcquireOutputPose(a_poseCache, a_evalContext);
 		auto resultSpan = result.get();
 		std::copy(pose.begin(), pose.end(), resultSpan.begin());
 
@@ -1,12 +1,24 @@
 #include "PTransformRangeNode.h"
+#include "PBatch.h"
 
 namespace Animation::Procedural
 {
-	PEvaluationResult PTransformRangeNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	float PTransformRangeNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
-		float value = std::get<float>(a_evalContext.results[inputs[0]]);
-		float result = (value - oldMin) * scale + newMin;
-		return std::clamp(result, newMin, newMax);
+		return Apply(GetRequiredInput<float>(0, a_evalContext));
+	}
+
+	PEvaluateBatchFunc PTransformRangeNode::GetEvaluateBatchFunc()
+	{
+		return &EvaluateBatch;
+	}
+
+	void PTransformRangeNode::EvaluateBatch(const PPlanStep& a_step, std::span<PEvaluationContext* const> a_evalContexts)
+	{
+		auto node = static_cast<PTransformRangeNode*>(a_step.node);
+		ForEachBatchGroup(a_evalContexts, [&](const PBatchGroup& a_group) {
+			ScatterFloats(a_group, node->resultSlot, node->Apply(GatherFloats(a_group, node->inputSlots[0])));
+		});
 	}
 
 	bool PTransformRangeNode::SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir)
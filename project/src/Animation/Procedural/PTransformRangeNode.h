@@ -11,8 +11,22 @@ namespace Animation::Procedural
 		float newMin;
 		float newMax;
 
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override;
+		inline float Apply(float a_value) const
+		{
+			return std::clamp((a_value - oldMin) * scale + newMin, newMin, newMax);
+		}
+
+		inline ozz::math::SimdFloat4 Apply(ozz::math::_SimdFloat4 a_values) const
+		{
+			using namespace ozz::math;
+			const SimdFloat4 min = simd_float4::Load1(newMin);
+			return Clamp(min, MAdd(a_values - simd_float4::Load1(oldMin), simd_float4::Load1(scale), min), simd_float4::Load1(newMax));
+		}
+
+		float Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext);
+		virtual PEvaluateBatchFunc GetEvaluateBatchFunc() override;
 		virtual bool SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir) override;
+		static void EvaluateBatch(const PPlanStep& a_step, std::span<PEvaluationContext* const> a_evalContexts);
 
 		inline static Registration _reg{
 			"transform_range",
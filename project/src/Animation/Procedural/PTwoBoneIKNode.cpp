@@ -4,22 +4,19 @@
 
 namespace Animation::Procedural
 {
-	std::unique_ptr<PNodeInstanceData> PTwoBoneIKAdjustNode::CreateInstanceData()
+	PNodeInstanceData* PTwoBoneIKAdjustNode::CreateInstanceData(void* a_memory)
 	{
-		return std::make_unique<InstanceData>();
+		return new (a_memory) InstanceData();
 	}
 
-	PEvaluationResult PTwoBoneIKAdjustNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	PoseCache::Handle PTwoBoneIKAdjustNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
 		// Get node input data.
-		PoseCache::Handle& input = std::get<PoseCache::Handle>(a_evalContext.results[inputs[0]]);
-		const ozz::math::Float4& target = std::get<ozz::math::Float4>(a_evalContext.results[inputs[1]]);
+		const ozz::math::Float4& target = GetRequiredInput<ozz::math::Float4>(1, a_evalContext);
 
-		// Acquire a pose handle for this node's output and copy the input pose to the output pose - we only need to make 3 corrections to the pose.
-		PoseCache::Handle output = a_poseCache.acquire_handle();
-		auto inputSpan = input.get();
+		// Get the input pose as this node's output - we only need to make 3 corrections to the pose.
+		PoseCache::Handle output = GetModifiablePose(0, a_poseCache, a_evalContext);
 		auto outputSpan = output.get();
-		std::copy(inputSpan.begin(), inputSpan.end(), outputSpan.begin());
 
 		// Calculate model-space matrices from the pose.
 		a_evalContext.UpdateModelSpaceCache(outputSpan);
@@ -52,6 +49,16 @@ namespace Animation::Procedural
 		return output;
 	}
 
+	uint32_t PTwoBoneIKAdjustNode::GetModifiedPoseInputs()
+	{
+		return 1;
+	}
+
+	bool PTwoBoneIKAdjustNode::CanEvaluateInParallel()
+	{
+		return false;
+	}
+
 	bool PTwoBoneIKAdjustNode::SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir)
 	{
 		const RE::BSFixedString startName = std::get<RE::BSFixedString>(a_values[0]);
@@ -3,18 +3,32 @@
 
 namespace Animation::Procedural
 {
-	std::unique_ptr<PNodeInstanceData> PVariableNode::CreateInstanceData()
+	PNodeInstanceData* PVariableNode::CreateInstanceData(void* a_memory)
 	{
-		auto result = std::make_unique<InstanceData>();
+		auto result = new (a_memory) InstanceData();
 		result->value = defaultValue;
 		return result;
 	}
 
-	PEvaluationResult PVariableNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
+	float PVariableNode::Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 	{
 		return static_cast<InstanceData*>(a_instanceData)->value;
 	}
 
+	PEvaluateBatchFunc PVariableNode::GetEvaluateBatchFunc()
+	{
+		return &EvaluateBatch;
+	}
+
+	void PVariableNode::EvaluateBatch(const PPlanStep& a_step, std::span<PEvaluationContext* const> a_evalContexts)
+	{
+		// Nothing to compute, but copying every instance's value in one loop still saves a call per instance.
+		const uint32_t slot = a_step.node->resultSlot;
+		for (auto ctx : a_evalContexts) {
+			ctx->results.floats[slot] = static_cast<InstanceData*>(ctx->nodeInstances[a_step.nodeIdx])->value;
+		}
+	}
+
 	void PVariableNode::Synchronize(PNodeInstanceData* a_instanceData, PNodeInstanceData* a_ownerInstance, float a_correctionDelta)
 	{
 		static_cast<InstanceData*>(a_instanceData)->value = static_cast<InstanceData*>(a_ownerInstance)->value;
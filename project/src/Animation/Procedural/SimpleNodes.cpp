@@ -12,7 +12,7 @@ namespace Animation::Procedural
 	class P##NAME##Node : public PNodeT<P##NAME##Node>
 	{
 	public:
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override {
+		retnType Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) {
 
 		}
 
@@ -42,11 +42,11 @@ namespace Animation::Procedural
 	public:
 		uint16_t parentBoneIdx;
 
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override
+		ozz::math::Float4 Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 		{
 			using namespace ozz::math;
-			const auto pose = std::get<PoseCache::Handle>(a_evalContext.results[inputs[0]]).get();
-			const Float4 vec = std::get<Float4>(a_evalContext.results[inputs[1]]);
+			const auto pose = GetRequiredInput<PoseCache::Handle>(0, a_evalContext).get();
+			const Float4 vec = GetRequiredInput<Float4>(1, a_evalContext);
 
 			a_evalContext.UpdateModelSpaceCache(pose, ozz::animation::Skeleton::kNoParent, parentBoneIdx);
 			const SimdFloat4 modelSpace = TransformPoint(a_evalContext.modelSpaceCache[parentBoneIdx], simd_float4::Load3PtrU(&vec.x));
@@ -56,6 +56,11 @@ namespace Animation::Procedural
 			return result;
 		}
 
+		virtual bool CanEvaluateInParallel() override
+		{
+			return false;
+		}
+
 		virtual bool SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir) override
 		{
 			const RE::BSFixedString& boneName = std::get<RE::BSFixedString>(a_values[0]);
@@ -90,9 +95,9 @@ namespace Animation::Procedural
 		bool isModelSpace;
 		uint16_t boneIdx;
 
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override
+		ozz::math::Float4 Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 		{
-			PoseCache::Handle& input = std::get<PoseCache::Handle>(a_evalContext.results[inputs[0]]);
+			PoseCache::Handle& input = GetRequiredInput<PoseCache::Handle>(0, a_evalContext);
 			ozz::math::SimdQuaternion rotation;
 
 			if (!isModelSpace) {
@@ -108,6 +113,11 @@ namespace Animation::Procedural
 			
 		}
 
+		virtual bool CanEvaluateInParallel() override
+		{
+			return false;
+		}
+
 		virtual bool SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir) override
 		{
 			const RE::BSFixedString& boneName = std::get<RE::BSFixedString>(a_values[0]);
@@ -145,20 +155,17 @@ namespace Animation::Procedural
 		uint16_t boneIdx;
 		uint16_t parentIdx;
 
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override
+		PoseCache::Handle Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 		{
-			PoseCache::Handle& input = GetRequiredInput<PoseCache::Handle>(0, a_evalContext);
 			ozz::math::Float4& rot = GetRequiredInput<ozz::math::Float4>(1, a_evalContext);
-			PoseCache::Handle output = a_poseCache.acquire_handle();
-			auto inputSpan = input.get();
+			PoseCache::Handle output = GetModifiablePose(0, a_poseCache, a_evalContext);
 			auto outputSpan = output.get();
-			std::copy(inputSpan.begin(), inputSpan.end(), outputSpan.begin());
 
 			const ozz::math::SimdQuaternion inputQuat{ .xyzw = ozz::math::simd_float4::LoadPtrU(&rot.x) };
 			if (!isModelSpace) {
 				Util::Ozz::ApplySoATransformQuaternion(boneIdx, inputQuat, outputSpan);
 			} else {
-				a_evalContext.UpdateModelSpaceCache(input.get(), ozz::animation::Skeleton::kNoParent, boneIdx);
+				a_evalContext.UpdateModelSpaceCache(outputSpan, ozz::animation::Skeleton::kNoParent, boneIdx);
 				const ozz::math::SimdQuaternion parentQuat = Util::Ozz::ToNormalizedQuaternion(a_evalContext.modelSpaceCache[parentIdx]);
 				Util::Ozz::ApplySoATransformQuaternion(boneIdx, Conjugate(parentQuat) * inputQuat, outputSpan);
 			}
@@ -166,6 +173,16 @@ namespace Animation::Procedural
 			return output;
 		}
 
+		virtual uint32_t GetModifiedPoseInputs() override
+		{
+			return 1;
+		}
+
+		virtual bool CanEvaluateInParallel() override
+		{
+			return false;
+		}
+
 		virtual bool SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir) override
 		{
 			const RE::BSFixedString& boneName = std::get<RE::BSFixedString>(a_values[0]);
@@ -209,9 +226,9 @@ namespace Animation::Procedural
 		bool isModelSpace;
 		uint16_t boneIdx;
 
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override
+		ozz::math::Float4 Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 		{
-			PoseCache::Handle& input = std::get<PoseCache::Handle>(a_evalContext.results[inputs[0]]);
+			PoseCache::Handle& input = GetRequiredInput<PoseCache::Handle>(0, a_evalContext);
 			ozz::math::SimdFloat4 position;
 
 			if (!isModelSpace) {
@@ -227,6 +244,11 @@ namespace Animation::Procedural
 			
 		}
 
+		virtual bool CanEvaluateInParallel() override
+		{
+			return false;
+		}
+
 		virtual bool SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir) override
 		{
 			const RE::BSFixedString& boneName = std::get<RE::BSFixedString>(a_values[0]);
@@ -264,20 +286,17 @@ namespace Animation::Procedural
 		uint16_t boneIdx;
 		uint16_t parentIdx;
 
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override
+		PoseCache::Handle Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 		{
-			PoseCache::Handle& input = GetRequiredInput<PoseCache::Handle>(0, a_evalContext);
 			ozz::math::Float4& pos = GetRequiredInput<ozz::math::Float4>(1, a_evalContext);
-			PoseCache::Handle output = a_poseCache.acquire_handle();
-			auto inputSpan = input.get();
+			PoseCache::Handle output = GetModifiablePose(0, a_poseCache, a_evalContext);
 			auto outputSpan = output.get();
-			std::copy(inputSpan.begin(), inputSpan.end(), outputSpan.begin());
 
 			const ozz::math::SimdFloat4 inputPos = ozz::math::simd_float4::Load3PtrU(&pos.x);
 			if (!isModelSpace) {
 				Util::Ozz::ApplySoATransformTranslation(boneIdx, inputPos, outputSpan);
 			} else {
-				a_evalContext.UpdateModelSpaceCache(input.get(), ozz::animation::Skeleton::kNoParent, boneIdx);
+				a_evalContext.UpdateModelSpaceCache(outputSpan, ozz::animation::Skeleton::kNoParent, boneIdx);
 				const ozz::math::Float4x4 parentInv = ozz::math::Invert(a_evalContext.modelSpaceCache[parentIdx]);
 				Util::Ozz::ApplySoATransformTranslation(boneIdx, ozz::math::TransformPoint(parentInv, inputPos), outputSpan);
 			}
@@ -285,6 +304,16 @@ namespace Animation::Procedural
 			return output;
 		}
 
+		virtual uint32_t GetModifiedPoseInputs() override
+		{
+			return 1;
+		}
+
+		virtual bool CanEvaluateInParallel() override
+		{
+			return false;
+		}
+
 		virtual bool SetCustomValues(const std::span<PEvaluationResult>& a_values, const OzzSkeleton* a_skeleton, const std::filesystem::path& a_localDir) override
 		{
 			const RE::BSFixedString& boneName = std::get<RE::BSFixedString>(a_values[0]);
@@ -327,7 +356,7 @@ namespace Animation::Procedural
 	public:
 		ozz::math::Float4 vec;
 
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override
+		ozz::math::Float4 Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 		{
 			return vec;
 		}
@@ -361,13 +390,13 @@ namespace Animation::Procedural
 	public:
 		ozz::math::Float4 vec;
 
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override
+		ozz::math::Float4 Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 		{
 			return ozz::math::Float4{
-				std::get<float>(a_evalContext.results[inputs[0]]),
-				std::get<float>(a_evalContext.results[inputs[1]]),
-				std::get<float>(a_evalContext.results[inputs[2]]),
-				std::get<float>(a_evalContext.results[inputs[3]]),
+				GetRequiredInput<float>(0, a_evalContext),
+				GetRequiredInput<float>(1, a_evalContext),
+				GetRequiredInput<float>(2, a_evalContext),
+				GetRequiredInput<float>(3, a_evalContext),
 			};
 		}
 
@@ -389,10 +418,10 @@ namespace Animation::Procedural
 	class PAddVectorsNode : public PNodeT<PAddVectorsNode>
 	{
 	public:
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override
+		ozz::math::Float4 Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 		{
-			return std::get<ozz::math::Float4>(a_evalContext.results[inputs[0]]) +
-			       std::get<ozz::math::Float4>(a_evalContext.results[inputs[1]]);
+			return GetRequiredInput<ozz::math::Float4>(0, a_evalContext) +
+			       GetRequiredInput<ozz::math::Float4>(1, a_evalContext);
 		}
 
 		inline static Registration _reg{
@@ -411,10 +440,10 @@ namespace Animation::Procedural
 	class PSubtractVectorsNode : public PNodeT<PSubtractVectorsNode>
 	{
 	public:
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override
+		ozz::math::Float4 Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 		{
-			return std::get<ozz::math::Float4>(a_evalContext.results[inputs[0]]) -
-			       std::get<ozz::math::Float4>(a_evalContext.results[inputs[1]]);
+			return GetRequiredInput<ozz::math::Float4>(0, a_evalContext) -
+			       GetRequiredInput<ozz::math::Float4>(1, a_evalContext);
 		}
 
 		inline static Registration _reg{
@@ -432,10 +461,10 @@ namespace Animation::Procedural
 	class PDivideVectorsNode : public PNodeT<PDivideVectorsNode>
 	{
 	public:
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override
+		ozz::math::Float4 Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 		{
-			return std::get<ozz::math::Float4>(a_evalContext.results[inputs[0]]) /
-			       std::get<ozz::math::Float4>(a_evalContext.results[inputs[1]]);
+			return GetRequiredInput<ozz::math::Float4>(0, a_evalContext) /
+			       GetRequiredInput<ozz::math::Float4>(1, a_evalContext);
 		}
 
 		inline static Registration _reg{
@@ -453,10 +482,10 @@ namespace Animation::Procedural
 	class PMultiplyVectorsNode : public PNodeT<PMultiplyVectorsNode>
 	{
 	public:
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override
+		ozz::math::Float4 Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 		{
-			return std::get<ozz::math::Float4>(a_evalContext.results[inputs[0]]) *
-			       std::get<ozz::math::Float4>(a_evalContext.results[inputs[1]]);
+			return GetRequiredInput<ozz::math::Float4>(0, a_evalContext) *
+			       GetRequiredInput<ozz::math::Float4>(1, a_evalContext);
 		}
 
 		inline static Registration _reg{
@@ -474,10 +503,10 @@ namespace Animation::Procedural
 	class PAddRotationVectorsNode : public PNodeT<PAddRotationVectorsNode>
 	{
 	public:
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override
+		ozz::math::Float4 Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 		{
-			const auto& v1 = std::get<ozz::math::Float4>(a_evalContext.results[inputs[0]]);
-			const auto& v2 = std::get<ozz::math::Float4>(a_evalContext.results[inputs[1]]);
+			const auto& v1 = GetRequiredInput<ozz::math::Float4>(0, a_evalContext);
+			const auto& v2 = GetRequiredInput<ozz::math::Float4>(1, a_evalContext);
 
 			ozz::math::SimdQuaternion q1, q2;
 			q1.xyzw = ozz::math::simd_float4::LoadPtrU(&v1.x);
@@ -503,10 +532,10 @@ namespace Animation::Procedural
 	class PSubtractRotationVectorsNode : public PNodeT<PSubtractRotationVectorsNode>
 	{
 	public:
-		virtual PEvaluationResult Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext) override
+		ozz::math::Float4 Evaluate(PNodeInstanceData* a_instanceData, PoseCache& a_poseCache, PEvaluationContext& a_evalContext)
 		{
-			const auto& v1 = std::get<ozz::math::Float4>(a_evalContext.results[inputs[0]]);
-			const auto& v2 = std::get<ozz::math::Float4>(a_evalContext.results[inputs[1]]);
+			const auto& v1 = GetRequiredInput<ozz::math::Float4>(0, a_evalContext);
+			const auto& v2 = GetRequiredInput<ozz::math::Float4>(1, a_evalContext);
 
 			ozz::math::SimdQuaternion q1, q2;
 			q1.xyzw = ozz::math::simd_float4::LoadPtrU(&v1.x);
@@ -0,0 +1,166 @@
+#include "QuantizedPose.h"
+
+namespace Animation
+{
+	namespace detail
+	{
+		constexpr float QUAT_COMPONENT_MAX = 0.70710678f;
+		constexpr float QUAT_QUANTIZE_STEPS = 32767.0f;
+		constexpr float SCALE_EPSILON = 1e-5f;
+
+		void EncodeHalfs(const ozz::math::SimdFloat4& a_value, uint16_t (&a_out)[4])
+		{
+			alignas(16) int halfs[4];
+			ozz::math::StorePtr(ozz::math::FloatToHalf(a_value), halfs);
+			for (size_t i = 0; i < 4; i++) {
+				a_out[i] = static_cast<uint16_t>(halfs[i]);
+			}
+		}
+
+		ozz::math::SimdFloat4 DecodeHalfs(const uint16_t (&a_in)[4])
+		{
+			return ozz::math::HalfToFloat(ozz::math::simd_int4::Load(a_in[0], a_in[1], a_in[2], a_in[3]));
+		}
+
+		uint16_t QuantizeQuatComponent(float a_value)
+		{
+			const float n = (a_value / QUAT_COMPONENT_MAX) * 0.5f + 0.5f;
+			return static_cast<uint16_t>(std::clamp(n, 0.0f, 1.0f) * QUAT_QUANTIZE_STEPS + 0.5f);
+		}
+
+		bool IsUnitScale(const ozz::math::SoaFloat3& a_scale)
+		{
+			alignas(16) float s[3][4];
+			ozz::math::StorePtr(a_scale.x, s[0]);
+			ozz::math::StorePtr(a_scale.y, s[1]);
+			ozz::math::StorePtr(a_scale.z, s[2]);
+			for (auto& c : s) {
+				for (float v : c) {
+					if (std::fabs(v - 1.0f) > SCALE_EPSILON)
+						return false;
+				}
+			}
+			return true;
+		}
+	}
+
+	void QuantizedPose::encode(std::span<const ozz::math::SoaTransform> a_pose)
+	{
+		_lanes.resize(a_pose.size());
+		_scales.clear();
+		_scaledLanes = SoaLaneMask(a_pose.size());
+
+		for (size_t l = 0; l < a_pose.size(); l++) {
+			const auto& in = a_pose[l];
+			auto& out = _lanes[l];
+			detail::EncodeHalfs(in.translation.x, out.translation[0]);
+			detail::EncodeHalfs(in.translation.y, out.translation[1]);
+			detail::EncodeHalfs(in.translation.z, out.translation[2]);
+
+			alignas(16) float q[4][4];
+			ozz::math::StorePtr(in.rotation.x, q[0]);
+			ozz::math::StorePtr(in.rotation.y, q[1]);
+			ozz::math::StorePtr(in.rotation.z, q[2]);
+			ozz::math::StorePtr(in.rotation.w, q[3]);
+
+			for (size_t j = 0; j < 4; j++) {
+				float c[4] = { q[0][j], q[1][j], q[2][j], q[3][j] };
+				const float len = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2] + c[3] * c[3]);
+				if (!(len > 0.0f) || !std::isfinite(len)) {
+					// Padding joints in the last lane aren't always initialized.
+					c[0] = c[1] = c[2] = 0.0f;
+					c[3] = 1.0f;
+				} else {
+					for (auto& v : c) {
+						v /= len;
+					}
+				}
+
+				uint16_t largest = 0;
+				for (uint16_t k = 1; k < 4; k++) {
+					if (std::fabs(c[k]) > std::fabs(c[largest])) {
+						largest = k;
+					}
+				}
+
+				// q and -q are the same rotation, so the dropped component is always made positive.
+				const float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+				for (uint16_t k = 0, s = 0; k < 4; k++) {
+					if (k != largest) {
+						out.rotation[s++][j] = detail::QuantizeQuatComponent(c[k] * sign);
+					}
+				}
+				out.rotation[0][j] |= (largest & 1) << 15;
+				out.rotation[1][j] |= (largest >> 1) << 15;
+			}
+
+			if (!detail::IsUnitScale(in.scale)) {
+				_scaledLanes.set(l);
+				_scales.push_back(in.scale);
+			}
+		}
+	}
+
+	bool QuantizedPose::decode(std::span<ozz::math::SoaTransform> a_output) const
+	{
+		if (a_output.size() != _lanes.size())
+			return false;
+
+		using namespace ozz::math;
+		const SimdFloat4 one = simd_float4::one();
+		const SimdFloat4 zero = simd_float4::zero();
+		const SimdFloat4 quatScale = simd_float4::Load1((detail::QUAT_COMPONENT_MAX * 2.0f) / detail::QUAT_QUANTIZE_STEPS);
+		const SimdFloat4 quatOffset = simd_float4::Load1(detail::QUAT_COMPONENT_MAX);
+		const SimdInt4 idx0 = simd_int4::Load1(0);
+		const SimdInt4 idx1 = simd_int4::Load1(1);
+		const SimdInt4 idx2 = simd_int4::Load1(2);
+		const SimdInt4 idx3 = simd_int4::Load1(3);
+		const SoaFloat3 unitScale = SoaFloat3::Load(one, one, one);
+
+		size_t scaleIdx = 0;
+		for (size_t l = 0; l < _lanes.size(); l++) {
+			const auto& in = _lanes[l];
+			auto& out = a_output[l];
+			out.translation.x = detail::DecodeHalfs(in.translation[0]);
+			out.translation.y = detail::DecodeHalfs(in.translation[1]);
+			out.translation.z = detail::DecodeHalfs(in.translation[2]);
+
+			const auto& r = in.rotation;
+			const SimdInt4 largest = simd_int4::Load(
+				(r[0][0] >> 15) | ((r[1][0] >> 15) << 1),
+				(r[0][1] >> 15) | ((r[1][1] >> 15) << 1),
+				(r[0][2] >> 15) | ((r[1][2] >> 15) << 1),
+				(r[0][3] >> 15) | ((r[1][3] >> 15) << 1));
+			const SimdFloat4 s0 = simd_float4::FromInt(simd_int4::Load(r[0][0] & 0x7FFF, r[0][1] & 0x7FFF, r[0][2] & 0x7FFF, r[0][3] & 0x7FFF)) * quatScale - quatOffset;
+			const SimdFloat4 s1 = simd_float4::FromInt(simd_int4::Load(r[1][0] & 0x7FFF, r[1][1] & 0x7FFF, r[1][2] & 0x7FFF, r[1][3] & 0x7FFF)) * quatScale - quatOffset;
+			const SimdFloat4 s2 = simd_float4::FromInt(simd_int4::Load(r[2][0], r[2][1], r[2][2], r[2][3])) * quatScale - quatOffset;
+			const SimdFloat4 dropped = Sqrt(Max(zero, one - (s0 * s0 + s1 * s1 + s2 * s2)));
+
+			// The stored components keep their order with the largest one removed.
+			out.rotation.x = Select(CmpEq(largest, idx0), dropped, s0);
+			out.rotation.y = Select(CmpEq(largest, idx1), dropped, Select(CmpEq(largest, idx0), s0, s1));
+			out.rotation.z = Select(CmpEq(largest, idx2), dropped, Select(CmpEq(largest, idx3), s2, s1));
+			out.rotation.w = Select(CmpEq(largest, idx3), dropped, s2);
+
+			out.scale = _scaledLanes.test(l) ? _scales[scaleIdx++] : unitScale;
+		}
+		return true;
+	}
+
+	bool QuantizedPose::empty() const
+	{
+		return _lanes.empty();
+	}
+
+	void QuantizedPose::clear()
+	{
+		_lanes.clear();
+		_scales.clear();
+		_scaledLanes = SoaLaneMask();
+	}
+
+	size_t QuantizedPose::heap_bytes() const
+	{
+		return Util::Memory::GetHeapBytes(_lanes) + Util::Memory::GetHeapBytes(_scales) + _scaledLanes.heap_bytes();
+	}
+}
\ No newline at end of file
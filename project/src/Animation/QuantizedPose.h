@@ -0,0 +1,31 @@
+#pragma once
+#include "PartialPose.h"
+
+namespace Animation
+{
+	// Compact storage for poses that are kept around but rarely read, such as transition snapshots. Rotations are stored
+	// as 48-bit smallest-three quaternions and translations as half floats. Scales are only stored for lanes where they
+	// aren't 1. A lane takes 48 bytes instead of the 160 bytes of a SoaTransform.
+	class QuantizedPose
+	{
+	public:
+		void encode(std::span<const ozz::math::SoaTransform> a_pose);
+		// Returns false if a_output doesn't have the same number of lanes as the encoded pose.
+		bool decode(std::span<ozz::math::SoaTransform> a_output) const;
+		bool empty() const;
+		void clear();
+		size_t heap_bytes() const;
+
+	private:
+		struct Lane
+		{
+			uint16_t translation[3][4];
+			// Three smallest components, with the index of the largest one in the top bits of the first two.
+			uint16_t rotation[3][4];
+		};
+
+		std::vector<Lane> _lanes;
+		std::vector<ozz::math::SoaFloat3> _scales;
+		SoaLaneMask _scaledLanes;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,298 @@
+#include "Replay.h"
+#include "PosePool.h"
+#include "Physics/ModelSpaceSystem.h"
+#include "Serialization/BlendGraphImport.h"
+#include "Settings/Settings.h"
+#include "Util/Ozz.h"
+#include "Util/Profiler.h"
+#include "Util/String.h"
+
+namespace Animation
+{
+	namespace detail
+	{
+		class ReplayReader
+		{
+		public:
+			ReplayReader(const std::vector<char>& a_stream) :
+				cur(a_stream.data()), end(a_stream.data() + a_stream.size())
+			{
+			}
+
+			template <typename T>
+			bool Read(T& a_out)
+			{
+				if (static_cast<size_t>(end - cur) < sizeof(T))
+					return false;
+
+				std::memcpy(&a_out, cur, sizeof(T));
+				cur += sizeof(T);
+				return true;
+			}
+
+			bool ReadString(std::string_view& a_out)
+			{
+				uint16_t len = 0;
+				if (!Read(len) || static_cast<size_t>(end - cur) < len)
+					return false;
+
+				a_out = std::string_view(cur, len);
+				cur += len;
+				return true;
+			}
+
+			bool AtEnd() const
+			{
+				return cur >= end;
+			}
+
+		private:
+			const char* cur;
+			const char* end;
+		};
+
+		uint64_t HashBytes(uint64_t a_hash, const void* a_data, size_t a_size)
+		{
+			auto bytes = static_cast<const uint8_t*>(a_data);
+			for (size_t i = 0; i < a_size; i++) {
+				a_hash ^= bytes[i];
+				a_hash *= 0x100000001B3ui64;
+			}
+			return a_hash;
+		}
+	}
+
+	ReplayRecorder::ReplayRecorder(const std::filesystem::path& a_path) :
+		file(a_path, std::ios::binary | std::ios::trunc)
+	{
+		if (!file.is_open()) {
+			logger::warn("Failed to open replay file '{}' for writing.", a_path.string());
+			return;
+		}
+
+		Write(Replay::MAGIC);
+		Write(Replay::VERSION);
+	}
+
+	bool ReplayRecorder::IsOpen() const
+	{
+		return file.is_open();
+	}
+
+	uint64_t ReplayRecorder::GetFrameCount() const
+	{
+		return frameCount;
+	}
+
+	void ReplayRecorder::RecordGenerator(Generator* a_generator, const std::string_view a_skeleton)
+	{
+		if (!file.is_open())
+			return;
+
+		Write(Replay::kGenerator);
+		if (a_generator) {
+			Write(a_generator->GetType());
+			WriteString(a_generator->GetSourceFile());
+		} else {
+			Write(GenType::kBase);
+			WriteString("");
+		}
+		WriteString(a_skeleton);
+	}
+
+	void ReplayRecorder::RecordVariable(const std::string_view a_name, float a_value)
+	{
+		if (!file.is_open())
+			return;
+
+		Write(Replay::kVariable);
+		WriteString(a_name);
+		Write(a_value);
+	}
+
+	void ReplayRecorder::RecordFrame(float a_deltaTime, bool a_visible, const Generator* a_generator, const ozz::math::Float4x4& a_rootTransform, const ozz::math::Float4x4& a_prevRootTransform)
+	{
+		if (!file.is_open())
+			return;
+
+		uint8_t frameFlags = Replay::kNoFlags;
+		float speed = 1.0f;
+		if (a_visible) {
+			frameFlags |= Replay::kVisible;
+		}
+		if (a_generator) {
+			speed = a_generator->speed;
+			if (a_generator->paused) {
+				frameFlags |= Replay::kPaused;
+			}
+		}
+
+		Write(Replay::kFrame);
+		Write(a_deltaTime);
+		Write(frameFlags);
+		Write(speed);
+		Write(a_rootTransform);
+		Write(a_prevRootTransform);
+		frameCount++;
+	}
+
+	void ReplayRecorder::WriteString(const std::string_view a_str)
+	{
+		const uint16_t len = static_cast<uint16_t>(std::min(a_str.size(), static_cast<size_t>(UINT16_MAX)));
+		Write(len);
+		file.write(a_str.data(), len);
+	}
+
+	bool ReplayPlayer::Load(const std::filesystem::path& a_path)
+	{
+		std::ifstream file(a_path, std::ios::binary | std::ios::ate);
+		if (!file.is_open()) {
+			logger::warn("Failed to open replay file '{}'.", a_path.string());
+			return false;
+		}
+
+		stream.resize(static_cast<size_t>(file.tellg()));
+		file.seekg(0);
+		file.read(stream.data(), stream.size());
+
+		detail::ReplayReader reader(stream);
+		uint32_t magic = 0;
+		uint16_t version = 0;
+		if (!reader.Read(magic) || !reader.Read(version) || magic != Replay::MAGIC || version != Replay::VERSION) {
+			logger::warn("'{}' is not a valid replay file.", a_path.string());
+			stream.clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	ReplayPlayer::Result ReplayPlayer::Play()
+	{
+		Result result;
+		result.outputHash = 0xCBF29CE484222325ui64;
+		if (stream.empty())
+			return result;
+
+		detail::ReplayReader reader(stream);
+		uint32_t magic;
+		uint16_t version;
+		reader.Read(magic);
+		reader.Read(version);
+
+		std::unique_ptr<GeneratorState> state = nullptr;
+		while (!reader.AtEnd()) {
+			Replay::RECORD_TYPE type;
+			if (!reader.Read(type))
+				break;
+
+			if (type == Replay::kGenerator) {
+				GenType genType;
+				std::string_view genFile;
+				std::string_view skeleton;
+				if (!reader.Read(genType) || !reader.ReadString(genFile) || !reader.ReadString(skeleton))
+					break;
+
+				state.reset();
+				state = CreateGeneratorState(genType, genFile, skeleton);
+			} else if (type == Replay::kVariable) {
+				std::string_view name;
+				float value;
+				if (!reader.ReadString(name) || !reader.Read(value))
+					break;
+
+				if (state) {
+					state->generator->SetVariable(name, value);
+				}
+			} else if (type == Replay::kFrame) {
+				float deltaTime;
+				uint8_t frameFlags;
+				float speed;
+				ozz::math::Float4x4 rootTransform;
+				ozz::math::Float4x4 prevRootTransform;
+				if (!reader.Read(deltaTime) || !reader.Read(frameFlags) || !reader.Read(speed) || !reader.Read(rootTransform) || !reader.Read(prevRootTransform))
+					break;
+
+				result.frames++;
+				if (!state) {
+					result.skippedFrames++;
+					continue;
+				}
+
+				auto gen = state->generator.get();
+				gen->speed = speed;
+				gen->paused = (frameFlags & Replay::kPaused) != 0;
+				state->rootTransform = rootTransform;
+				state->prevRootTransform = prevRootTransform;
+
+				// Mirrors the generator path of Graph::Update.
+				const uint64_t start = Util::Profiler::ReadTimestamp();
+				gen->AdvanceTime(deltaTime);
+				std::span<ozz::math::SoaTransform> output;
+				if (frameFlags & Replay::kVisible) {
+					if (state->physSystem) {
+						state->physSystem->Update(deltaTime, state->rootTransform, state->prevRootTransform);
+					}
+					PoseCache& genCache = gen->UsesTransientPoses() ? PosePool::GetScratch(state->skeleton->data->num_soa_joints()) : state->poseCache;
+					output = gen->Generate(genCache, nullptr);
+					if (!output.empty()) {
+						Util::Ozz::UnpackSoaTransforms(output, state->modelSpaceCache, state->skeleton->data.get());
+					}
+				}
+				const double frameMs = Util::Profiler::TicksToMs(Util::Profiler::ReadTimestamp() - start);
+
+				result.evaluatedFrames++;
+				result.totalMs += frameMs;
+				result.maxFrameMs = std::max(result.maxFrameMs, frameMs);
+				result.outputHash = detail::HashBytes(result.outputHash, output.data(), output.size_bytes());
+				gen->ReleaseTransientPoses();
+			} else {
+				logger::warn("Encountered unknown replay record type {}, stopping playback.", static_cast<uint8_t>(type));
+				break;
+			}
+		}
+
+		return result;
+	}
+
+	std::unique_ptr<ReplayPlayer::GeneratorState> ReplayPlayer::CreateGeneratorState(GenType a_type, const std::string_view a_file, const std::string_view a_skeleton)
+	{
+		if (a_type != GenType::kProcedural)
+			return nullptr;
+
+		// Falls back to the default skeleton if the recorded one isn't loaded.
+		auto skeleton = Settings::GetSkeleton(std::string(a_skeleton));
+		auto& graph = graphs[{ std::string(a_file), std::string(a_skeleton) }];
+		if (!graph) {
+			const std::filesystem::path localPath = a_file;
+			graph = Serialization::BlendGraphImport::LoadGraph(Util::String::GetDataPath() / localPath, localPath.parent_path(), a_skeleton);
+			if (!graph) {
+				logger::warn("Failed to load blend graph '{}' for replay.", a_file);
+				return nullptr;
+			}
+		}
+
+		auto s = std::make_unique<GeneratorState>();
+		s->skeleton = skeleton;
+		s->poseCache.set_pose_size(skeleton->data->num_soa_joints());
+		s->poseCache.reserve(4);
+		s->restPose = s->poseCache.acquire_handle();
+		const auto restPoses = skeleton->data->joint_rest_poses();
+		std::copy(restPoses.begin(), restPoses.end(), s->restPose.get().begin());
+		s->modelSpaceCache.resize(skeleton->data->num_joints(), ozz::math::Float4x4::identity());
+
+		s->generator = std::make_unique<ProceduralGenerator>(graph);
+		if (s->generator->RequiresPhysicsSystem()) {
+			s->physSystem = std::make_unique<Physics::ModelSpaceSystem>();
+		}
+		s->generator->SetContext({
+			.modelSpaceCache = s->modelSpaceCache,
+			.prevRootTransform = &s->prevRootTransform,
+			.rootTransform = &s->rootTransform,
+			.restPose = &s->restPose,
+			.skeleton = skeleton.get(),
+			.physSystem = s->physSystem.get()
+		});
+		return s;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+#include "Generator.h"
+#include "PoseCache.h"
+
+namespace Physics
+{
+	class ModelSpaceSystem;
+}
+
+namespace Animation
+{
+	// Stream layout: a header (MAGIC, VERSION) followed by records, each prefixed with a RECORD_TYPE byte.
+	// Strings are stored as a uint16_t length followed by the raw characters.
+	namespace Replay
+	{
+		inline constexpr uint32_t MAGIC{ 0x4E414652 };
+		inline constexpr uint16_t VERSION{ 1 };
+
+		enum RECORD_TYPE : uint8_t
+		{
+			kGenerator = 0,
+			kVariable = 1,
+			kFrame = 2
+		};
+
+		enum FRAME_FLAGS : uint8_t
+		{
+			kNoFlags = 0,
+			kVisible = 1u << 0,
+			kPaused = 1u << 1
+		};
+	}
+
+	class ReplayRecorder
+	{
+	public:
+		ReplayRecorder(const std::filesystem::path& a_path);
+
+		bool IsOpen() const;
+		uint64_t GetFrameCount() const;
+		void RecordGenerator(Generator* a_generator, const std::string_view a_skeleton);
+		void RecordVariable(const std::string_view a_name, float a_value);
+		void RecordFrame(float a_deltaTime, bool a_visible, const Generator* a_generator, const ozz::math::Float4x4& a_rootTransform, const ozz::math::Float4x4& a_prevRootTransform);
+
+	private:
+		template <typename T>
+		void Write(const T& a_value)
+		{
+			file.write(reinterpret_cast<const char*>(&a_value), sizeof(T));
+		}
+
+		void WriteString(const std::string_view a_str);
+
+		std::ofstream file;
+		uint64_t frameCount = 0;
+	};
+
+	// Re-drives procedural generators from a recorded stream. Game nodes are stubbed: the rest pose comes from the
+	// skeleton's bind pose and root transforms come from the stream, so repeated runs of the same stream are bit-exact.
+	class ReplayPlayer
+	{
+	public:
+		struct Result
+		{
+			uint64_t frames = 0;
+			uint64_t evaluatedFrames = 0;
+			uint64_t skippedFrames = 0;
+			double totalMs = 0.0;
+			double maxFrameMs = 0.0;
+			// Combined hash of every generated pose, for comparing runs before and after a change.
+			uint64_t outputHash = 0;
+		};
+
+		bool Load(const std::filesystem::path& a_path);
+		Result Play();
+
+	private:
+		// The pose cache is declared first so it outlives any handles held by the generator's instance data.
+		struct GeneratorState
+		{
+			PoseCache poseCache;
+			PoseCache::Handle restPose;
+			std::shared_ptr<const OzzSkeleton> skeleton;
+			std::unique_ptr<Physics::ModelSpaceSystem> physSystem;
+			std::vector<ozz::math::Float4x4> modelSpaceCache;
+			ozz::math::Float4x4 rootTransform = ozz::math::Float4x4::identity();
+			ozz::math::Float4x4 prevRootTransform = ozz::math::Float4x4::identity();
+			std::unique_ptr<ProceduralGenerator> generator;
+		};
+
+		std::unique_ptr<GeneratorState> CreateGeneratorState(GenType a_type, const std::string_view a_file, const std::string_view a_skeleton);
+
+		std::vector<char> stream;
+		std::map<std::pair<std::string, std::string>, std::shared_ptr<Procedural::PGraph>> graphs;
+	};
+}
\ No newline at end of file
@@ -38,7 +38,7 @@ namespace Animation
 			bool ownerUpdatedThisFrame = false;
 		};
 
-		Util::Guarded<InstData> data;
+		Util::Guarded<InstData, Util::Locks::Mutex<"SyncInstance::data">> data;
 
 		bool Synchronize(Graph* a_grph, const std::function<void(Graph*, bool)>& a_visitFunc);
 		void AddMember(Graph* a_grph, bool a_addAsOwner);
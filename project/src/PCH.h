@@ -56,6 +56,7 @@
 #include <iterator>
 #include <latch>
 #include <limits>
+#include <list>
 #include <locale>
 #include <map>
 #include <memory>
@@ -1,6 +1,7 @@
 #include "Body.h"
 #include "ModelSpaceSystem.h"
 #include "Util/Ozz.h"
+#include "Util/Profiler.h"
 
 namespace Physics
 {
@@ -9,6 +10,7 @@ namespace Physics
 
 	Transform Body::Update(const UpdateContext& a_context)
 	{
+		PROFILE_ZONE("Physics::Body::Update");
 		const uint8_t steps = a_context.system->simData.requiredSteps;
 
 		SimdInt4 invertible;
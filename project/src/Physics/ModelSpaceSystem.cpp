@@ -1,9 +1,11 @@
 #include "ModelSpaceSystem.h"
+#include "Util/Profiler.h"
 
 namespace Physics
 {
 	void ModelSpaceSystem::Update(float a_deltaTime, const ozz::math::Float4x4& a_rootTransform, const ozz::math::Float4x4& a_prevRootTransform)
 	{
+		PROFILE_ZONE("Physics::ModelSpaceSystem::Update");
 		using namespace ozz::math;
 		SimdInt4 invertible;
 		const Float4x4 rootInverseWS = Invert(a_rootTransform, &invertible);
@@ -129,6 +129,16 @@ namespace Serialization
 				throw std::exception{ "Blend graph contains no actor node." };
 			}
 
+			bool parallel = false;
+			if (doc["parallel"].get_bool().get(parallel) == simdjson::SUCCESS) {
+				result->parallelEvaluation = parallel;
+			}
+
+			bool pruning = false;
+			if (doc["pruning"].get_bool().get(pruning) == simdjson::SUCCESS) {
+				result->branchPruning = pruning;
+			}
+
 			//Pass 2: Connect inputs together.
 			for (auto& n : result->nodes) {
 				auto destTypeInfo = n->GetTypeInfo();
@@ -165,7 +175,12 @@ namespace Serialization
 				}
 			}
 
-			//Pass 4: Cache data for special nodes.
+			//Pass 4: Fold constants and skip blends that only select one input.
+			if (const size_t removed = result->FoldConstants(); removed > 0) {
+				logger::debug("Removed {} node(s) from blend graph '{}'.", removed, a_filePath.filename().generic_string());
+			}
+
+			//Pass 5: Cache data for special nodes.
 			for (auto& n : result->nodes) {
 				auto destTypeInfo = n->GetTypeInfo();
 				if (destTypeInfo == &PFullAnimationNode::_reg) {
@@ -188,9 +203,12 @@ namespace Serialization
 				throw std::exception{ "Failed to sort nodes (either due to a dependency loop or too many nodes.)" };
 			}
 
-			result->InsertCacheReleaseNodes(sortedNodes);
+			result->AllocatePoseSlots(sortedNodes);
 			result->PointersToIndexes(sortedNodes);
 			result->EmplaceNodeOrder(sortedNodes);
+			result->AssignResultSlots();
+			result->BuildPlan();
+			result->LayoutInstanceData();
 		}
 		catch (const std::exception& ex) {
 			logger::warn("{}", ex.what());
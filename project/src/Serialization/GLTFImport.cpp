@@ -430,25 +430,44 @@ namespace Serialization
 
 	std::unique_ptr<GLTFImport::AssetData> GLTFImport::LoadGLTF(const std::filesystem::path& fileName)
 	{
+		std::vector<uint8_t> buffer;
+		size_t bufferSize = 0;
+		if (!ReadGLTFBuffer(fileName, buffer, bufferSize))
+			return nullptr;
+
+		return ParseGLTF(buffer, bufferSize, fileName.parent_path());
+	}
+
+	bool GLTFImport::ReadGLTFBuffer(const std::filesystem::path& fileName, std::vector<uint8_t>& buffer, size_t& bufferSize)
+	{
+		constexpr size_t CHUNK_SIZE = 1u << 16;
+
 		try {
 			zstr::ifstream file(fileName.generic_string(), std::ios::binary);
 
 			if (file.bad())
-				return nullptr;
-
-			std::vector<uint8_t> buffer;
-			std::istreambuf_iterator<char> fileEnd;
-
-			for (std::istreambuf_iterator<char> iter(file); iter != fileEnd; iter++) {
-				buffer.push_back(*iter);
+				return false;
+
+			buffer.clear();
+			bufferSize = 0;
+			while (file) {
+				buffer.resize(bufferSize + CHUNK_SIZE);
+				file.read(reinterpret_cast<char*>(buffer.data() + bufferSize), CHUNK_SIZE);
+				bufferSize += static_cast<size_t>(file.gcount());
 			}
 
-			size_t baseBufferSize = buffer.size();
-			size_t paddedBufferSize = baseBufferSize + fastgltf::getGltfBufferPadding();
-			buffer.resize(paddedBufferSize);
+			buffer.resize(bufferSize + fastgltf::getGltfBufferPadding());
+			return true;
+		} catch (const std::exception&) {
+			return false;
+		}
+	}
 
+	std::unique_ptr<GLTFImport::AssetData> GLTFImport::ParseGLTF(std::vector<uint8_t>& buffer, size_t bufferSize, const std::filesystem::path& directory)
+	{
+		try {
 			fastgltf::GltfDataBuffer data;
-			data.fromByteView(buffer.data(), baseBufferSize, paddedBufferSize);
+			data.fromByteView(buffer.data(), bufferSize, buffer.size());
 
 			fastgltf::Parser parser;
 			auto gltfOptions =
@@ -494,7 +513,7 @@ namespace Serialization
 				}
 			});
 
-			auto gltf = parser.loadGltf(&data, fileName.parent_path(), gltfOptions, gltfCategories);
+			auto gltf = parser.loadGltf(&data, directory, gltfOptions, gltfCategories);
 			if (auto err = gltf.error(); err != fastgltf::Error::None) {
 				return nullptr;
 			}
@@ -58,5 +58,8 @@ namespace Serialization
 		static std::unique_ptr<Animation::RawOzzAnimation> CreateRawAnimation(const AssetData* assetData, const fastgltf::Animation* anim, const Animation::OzzSkeleton* skeleton);
 		static std::unique_ptr<Animation::OzzAnimation> CreateRuntimeAnimation(const AssetData* assetData, const fastgltf::Animation* anim, const Animation::OzzSkeleton* skeleton);
 		static std::unique_ptr<AssetData> LoadGLTF(const std::filesystem::path& fileName);
+		// Reads and, if gzipped, decompresses a file into a buffer padded for fastgltf. bufferSize receives the unpadded size.
+		static bool ReadGLTFBuffer(const std::filesystem::path& fileName, std::vector<uint8_t>& buffer, size_t& bufferSize);
+		static std::unique_ptr<AssetData> ParseGLTF(std::vector<uint8_t>& buffer, size_t bufferSize, const std::filesystem::path& directory);
 	};
 }
\ No newline at end of file
@@ -31,6 +31,7 @@ namespace Settings
 
 	void Init()
 	{
+		Util::Memory::InstallOzzAllocator();
 		InitDefaultSkeleton();
 	}
 
@@ -74,6 +75,18 @@ namespace Settings
 		}
 	}
 
+	void RegisterSkeleton(const std::shared_ptr<Animation::OzzSkeleton>& a_skeleton)
+	{
+		std::unique_lock l{ lock };
+		GetSkeletonMap()[a_skeleton->name] = a_skeleton;
+	}
+
+	void UnregisterSkeleton(const std::string& a_name)
+	{
+		std::unique_lock l{ lock };
+		GetSkeletonMap().erase(a_name);
+	}
+
 	std::shared_ptr<const Animation::OzzSkeleton> GetSkeleton(RE::Actor* a_actor)
 	{
 		if (!a_actor)
@@ -82,6 +95,19 @@ namespace Settings
 		return GetSkeleton(GetSkeletonIdentifier(a_actor).c_str());
 	}
 
+	void GetSkeletonMemoryReport(Util::Memory::MemoryReport& a_report)
+	{
+		std::unique_lock l{ lock };
+		if (auto& defaultSkeleton = GetDefaultSkeleton(); defaultSkeleton) {
+			a_report.AddChild(defaultSkeleton->name, defaultSkeleton->GetSizeBytes());
+		}
+		for (auto& [id, skeleton] : GetSkeletonMap()) {
+			if (skeleton) {
+				a_report.AddChild(id, skeleton->GetSizeBytes());
+			}
+		}
+	}
+
 	RE::BSFixedString GetSkeletonIdentifier(RE::Actor* a_actor)
 	{
 	#if defined TARGET_GAME_F4
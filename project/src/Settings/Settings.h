@@ -1,6 +1,7 @@
 #pragma once
 #include "SkeletonDescriptor.h"
 #include "Animation/Ozz.h"
+#include "Util/Memory.h"
 
 namespace Settings
 {
@@ -8,8 +9,12 @@ namespace Settings
 	const std::filesystem::path& GetSkeletonsPath();
 	std::unordered_map<std::string, std::shared_ptr<Animation::OzzSkeleton>>& GetSkeletonMap();
 	std::shared_ptr<const Animation::OzzSkeleton> GetSkeleton(const std::string& a_behPath);
+	// Registers a_skeleton under its name, replacing any skeleton already registered with that name.
+	void RegisterSkeleton(const std::shared_ptr<Animation::OzzSkeleton>& a_skeleton);
+	void UnregisterSkeleton(const std::string& a_name);
 	std::shared_ptr<const Animation::OzzSkeleton> GetSkeleton(RE::Actor* a_actor);
 	RE::BSFixedString GetSkeletonIdentifier(RE::Actor* a_actor);
+	void GetSkeletonMemoryReport(Util::Memory::MemoryReport& a_report);
 	bool IsDefaultSkeleton(std::shared_ptr<const Animation::OzzSkeleton> a_skeleton);
 	const std::map<std::string, size_t>& GetFaceMorphIndexMap();
 	const std::vector<std::string>& GetFaceMorphs();
@@ -130,24 +130,23 @@ namespace Settings
 #endif
 
 		int32_t numJoints = result->data->num_joints();
-		result->defaultBoneMask.reserve(numJoints);
-		result->controlledByGameMask.reserve(numJoints);
 		result->defaultBoneMask.resize(numJoints, true);
 		result->controlledByGameMask.resize(numJoints, true);
 
 		for (auto& mb : maskedBones) {
 			int32_t idx = detail::GetJointIndexCI(result->data.get(), mb);
 			if (idx >= 0) {
-				result->defaultBoneMask[idx] = false;
+				result->defaultBoneMask.set(idx, false);
 			}
 		}
 
 		for (auto& ucb : uncontrolledBones) {
 			int32_t idx = detail::GetJointIndexCI(result->data.get(), ucb);
 			if (idx >= 0) {
-				result->controlledByGameMask[idx] = false;
+				result->controlledByGameMask.set(idx, false);
 			}
 		}
+		result->gameControlledLanes = Animation::SoaLaneMask::FromJointMask(result->controlledByGameMask);
 
 		result->name = name;
 		return result;
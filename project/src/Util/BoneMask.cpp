@@ -0,0 +1,96 @@
+#include "BoneMask.h"
+#include "Memory.h"
+
+namespace Util
+{
+	BoneMask::BoneMask(size_t a_size, bool a_value)
+	{
+		resize(a_size, a_value);
+	}
+
+	void BoneMask::resize(size_t a_size, bool a_value)
+	{
+		_size = a_size;
+		_words.assign((a_size + 63) / 64, a_value ? UINT64_MAX : 0);
+		if (const size_t tail = a_size % 64; a_value && tail != 0) {
+			_words.back() = (1ui64 << tail) - 1;
+		}
+		build_runs();
+	}
+
+	void BoneMask::set(size_t a_idx, bool a_value)
+	{
+		if (test(a_idx) == a_value) {
+			return;
+		}
+
+		_words[a_idx / 64] ^= 1ui64 << (a_idx % 64);
+		build_runs();
+	}
+
+	bool BoneMask::test(size_t a_idx) const
+	{
+		return (_words[a_idx / 64] >> (a_idx % 64)) & 1;
+	}
+
+	bool BoneMask::operator[](size_t a_idx) const
+	{
+		return test(a_idx);
+	}
+
+	uint8_t BoneMask::lane_bits(size_t a_lane) const
+	{
+		// Lanes are 4 bits and never straddle a word.
+		return (_words[a_lane / 16] >> ((a_lane % 16) * 4)) & 0xF;
+	}
+
+	uint8_t BoneMask::lane_full_bits(size_t a_lane) const
+	{
+		const size_t remaining = _size - a_lane * 4;
+		return remaining >= 4 ? 0xF : static_cast<uint8_t>((1u << remaining) - 1);
+	}
+
+	size_t BoneMask::count() const
+	{
+		size_t result = 0;
+		for (auto w : _words) {
+			result += std::popcount(w);
+		}
+		return result;
+	}
+
+	size_t BoneMask::size() const
+	{
+		return _size;
+	}
+
+	size_t BoneMask::heap_bytes() const
+	{
+		return Memory::GetHeapBytes(_words) + Memory::GetHeapBytes(_runs);
+	}
+
+	void BoneMask::build_runs()
+	{
+		_runs.clear();
+		size_t i = 0;
+		while (i < _size) {
+			// Skip to the next set bit, then to the next clear bit, a whole word at a time.
+			const uint64_t bits = _words[i / 64] >> (i % 64);
+			if (bits == 0) {
+				i = (i / 64 + 1) * 64;
+				continue;
+			}
+			i += std::countr_zero(bits);
+
+			const uint32_t begin = static_cast<uint32_t>(i);
+			while (i < _size) {
+				const size_t ones = std::countr_one(_words[i / 64] >> (i % 64));
+				i += ones;
+				if (ones < 64 - (i - ones) % 64) {
+					break;
+				}
+			}
+			_runs.push_back({ begin, static_cast<uint32_t>(std::min(i, _size)) });
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+namespace Util
+{
+	// One bit per joint, packed into 64-bit words. Runs of consecutive set joints are kept up to date on every change,
+	// so hot loops can copy whole runs instead of testing each joint.
+	class BoneMask
+	{
+	public:
+		struct Run
+		{
+			uint32_t begin;
+			uint32_t end;
+		};
+
+		BoneMask() = default;
+		BoneMask(size_t a_size, bool a_value);
+
+		void resize(size_t a_size, bool a_value);
+		void set(size_t a_idx, bool a_value);
+		bool test(size_t a_idx) const;
+		bool operator[](size_t a_idx) const;
+		// Returns the 4 bits of a SoA lane, with joint (a_lane * 4) in the lowest bit.
+		uint8_t lane_bits(size_t a_lane) const;
+		// Returns the bits that are valid for a SoA lane, which is only less than 0xF for a partial last lane.
+		uint8_t lane_full_bits(size_t a_lane) const;
+		size_t count() const;
+		size_t size() const;
+		size_t heap_bytes() const;
+
+		// Calls a_func(idx) for every set joint.
+		template <typename F>
+		void for_each_set(F&& a_func) const
+		{
+			for (size_t w = 0; w < _words.size(); w++) {
+				for (uint64_t bits = _words[w]; bits != 0; bits &= bits - 1) {
+					a_func(w * 64 + std::countr_zero(bits));
+				}
+			}
+		}
+
+		// Calls a_func(begin, end) for every run of consecutive set joints.
+		template <typename F>
+		void for_each_run(F&& a_func) const
+		{
+			for (auto& r : _runs) {
+				a_func(r.begin, r.end);
+			}
+		}
+
+	private:
+		void build_runs();
+
+		std::vector<uint64_t> _words;
+		std::vector<Run> _runs;
+		size_t _size = 0;
+	};
+}
\ No newline at end of file
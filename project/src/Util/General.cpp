@@ -45,4 +45,56 @@ namespace Util
 		std::uniform_real_distribution<float> dist(a_min, a_max);
 		return dist(rand_engine);
 	}
+
+	namespace Locks
+	{
+		namespace detail
+		{
+			std::mutex sitesLock;
+			std::deque<LockSite> sites;
+
+			LockSite* RegisterSite(const std::string_view a_name)
+			{
+				std::unique_lock l{ sitesLock };
+				for (auto& s : sites) {
+					if (s.name == a_name) {
+						return &s;
+					}
+				}
+
+				auto& result = sites.emplace_back();
+				result.name = a_name;
+				return &result;
+			}
+		}
+
+		std::vector<LockSiteStats> GetLockStats()
+		{
+			std::vector<LockSiteStats> result;
+			std::unique_lock l{ detail::sitesLock };
+			for (auto& s : detail::sites) {
+				result.push_back({ .name = s.name,
+					.acquisitions = s.acquisitions.load(std::memory_order_relaxed),
+					.contendedAcquisitions = s.contendedAcquisitions.load(std::memory_order_relaxed),
+					.waitMs = Profiler::TicksToMs(s.waitTicks.load(std::memory_order_relaxed)),
+					.maxWaitMs = Profiler::TicksToMs(s.maxWaitTicks.load(std::memory_order_relaxed)) });
+			}
+
+			std::sort(result.begin(), result.end(), [](const LockSiteStats& a, const LockSiteStats& b) {
+				return a.waitMs > b.waitMs;
+			});
+			return result;
+		}
+
+		void ResetLockStats()
+		{
+			std::unique_lock l{ detail::sitesLock };
+			for (auto& s : detail::sites) {
+				s.acquisitions.store(0, std::memory_order_relaxed);
+				s.contendedAcquisitions.store(0, std::memory_order_relaxed);
+				s.waitTicks.store(0, std::memory_order_relaxed);
+				s.maxWaitTicks.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
 }
\ No newline at end of file
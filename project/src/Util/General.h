@@ -1,5 +1,6 @@
 #pragma once
 #include "Trampoline.h"
+#include "Profiler.h"
 
 template <typename T, typename Variant>
 struct variant_index;
@@ -46,7 +47,134 @@ namespace Util
 	int GetRandomInt(int a_min, int a_max);
 	float GetRandomFloat(float a_min, float a_max);
 
-	template <typename T, typename M = std::mutex, typename WL = std::unique_lock<M>, typename RL = std::shared_lock<M>>
+	namespace Locks
+	{
+		struct LockSiteStats
+		{
+			std::string_view name;
+			uint64_t acquisitions = 0;
+			uint64_t contendedAcquisitions = 0;
+			double waitMs = 0.0;
+			double maxWaitMs = 0.0;
+		};
+
+		namespace detail
+		{
+			struct LockSite
+			{
+				std::string_view name;
+				std::atomic<uint64_t> acquisitions{ 0 };
+				std::atomic<uint64_t> contendedAcquisitions{ 0 };
+				std::atomic<uint64_t> waitTicks{ 0 };
+				std::atomic<uint64_t> maxWaitTicks{ 0 };
+
+				inline void OnAcquired()
+				{
+					acquisitions.fetch_add(1, std::memory_order_relaxed);
+				}
+
+				inline void OnContendedAcquired(uint64_t a_waitTicks)
+				{
+					acquisitions.fetch_add(1, std::memory_order_relaxed);
+					contendedAcquisitions.fetch_add(1, std::memory_order_relaxed);
+					waitTicks.fetch_add(a_waitTicks, std::memory_order_relaxed);
+
+					uint64_t maxTicks = maxWaitTicks.load(std::memory_order_relaxed);
+					while (a_waitTicks > maxTicks && !maxWaitTicks.compare_exchange_weak(maxTicks, a_waitTicks, std::memory_order_relaxed)) {}
+				}
+			};
+
+			// Sites are never freed, so the returned pointer stays valid. Registering the same name twice returns the same site.
+			LockSite* RegisterSite(const std::string_view a_name);
+		}
+
+		// Wraps a mutex and counts acquisitions, contended acquisitions and the time spent waiting on contended acquisitions.
+		// Every mutex instantiated with the same NAME reports to the same site, e.g. all Graph::lock instances.
+		template <string_literal NAME, typename M = std::mutex>
+		class InstrumentedMutex
+		{
+		public:
+			void lock()
+			{
+				if (mutex.try_lock()) {
+					GetSite()->OnAcquired();
+					return;
+				}
+
+				const uint64_t start = Profiler::ReadTimestamp();
+				mutex.lock();
+				GetSite()->OnContendedAcquired(Profiler::ReadTimestamp() - start);
+			}
+
+			bool try_lock()
+			{
+				if (mutex.try_lock()) {
+					GetSite()->OnAcquired();
+					return true;
+				}
+				return false;
+			}
+
+			void unlock()
+			{
+				mutex.unlock();
+			}
+
+			void lock_shared()
+				requires requires(M& a_mutex) { a_mutex.lock_shared(); }
+			{
+				if (mutex.try_lock_shared()) {
+					GetSite()->OnAcquired();
+					return;
+				}
+
+				const uint64_t start = Profiler::ReadTimestamp();
+				mutex.lock_shared();
+				GetSite()->OnContendedAcquired(Profiler::ReadTimestamp() - start);
+			}
+
+			bool try_lock_shared()
+				requires requires(M& a_mutex) { a_mutex.try_lock_shared(); }
+			{
+				if (mutex.try_lock_shared()) {
+					GetSite()->OnAcquired();
+					return true;
+				}
+				return false;
+			}
+
+			void unlock_shared()
+				requires requires(M& a_mutex) { a_mutex.unlock_shared(); }
+			{
+				mutex.unlock_shared();
+			}
+
+		private:
+			static detail::LockSite* GetSite()
+			{
+				static detail::LockSite* site = detail::RegisterSite(NAME.value);
+				return site;
+			}
+
+			M mutex;
+		};
+
+		std::vector<LockSiteStats> GetLockStats();
+		void ResetLockStats();
+
+		// Lock sites use Mutex<"Name"> so instrumentation can be switched on with NAF_LOCK_TELEMETRY without touching call sites.
+#ifdef NAF_LOCK_TELEMETRY
+		template <string_literal NAME, typename M = std::mutex>
+		using Mutex = InstrumentedMutex<NAME, M>;
+		using ConditionVariable = std::condition_variable_any;
+#else
+		template <string_literal NAME, typename M = std::mutex>
+		using Mutex = M;
+		using ConditionVariable = std::condition_variable;
+#endif
+	}
+
+	template <typename T, typename M = Locks::Mutex<"Util::Guarded">, typename WL = std::unique_lock<M>, typename RL = std::shared_lock<M>>
 	class Guarded
 	{
 	public:
@@ -0,0 +1,173 @@
+#include "Memory.h"
+#include "ozz/base/memory/allocator.h"
+
+namespace Util::Memory
+{
+	namespace detail
+	{
+#ifdef NAF_MEMORY_TELEMETRY
+		class CountingOzzAllocator : public ozz::memory::Allocator
+		{
+		public:
+			CountingOzzAllocator(ozz::memory::Allocator* a_base) :
+				base(a_base)
+			{
+			}
+
+			virtual void* Allocate(size_t a_size, size_t a_alignment) override
+			{
+				void* result = base->Allocate(a_size, a_alignment);
+				if (!result)
+					return nullptr;
+
+				// ozz doesn't pass the block size back on deallocation, so sizes are kept on the side rather than in a
+				// header, which would break blocks allocated before the allocator was installed.
+				std::unique_lock l{ lock };
+				sizes.emplace(result, a_size);
+				OnAllocate(Tag::kOzz, a_size);
+				return result;
+			}
+
+			virtual void Deallocate(void* a_block) override
+			{
+				if (!a_block)
+					return;
+
+				{
+					std::unique_lock l{ lock };
+					if (auto iter = sizes.find(a_block); iter != sizes.end()) {
+						OnDeallocate(Tag::kOzz, iter->second);
+						sizes.erase(iter);
+					}
+				}
+				base->Deallocate(a_block);
+			}
+
+		private:
+			ozz::memory::Allocator* base;
+			std::mutex lock;
+			std::unordered_map<void*, size_t> sizes;
+		};
+#endif
+
+		constexpr std::array<std::string_view, static_cast<size_t>(Tag::kTotal)> TAG_NAMES = {
+			"PoseCache",
+			"Ozz"
+		};
+
+		void AppendEscaped(std::string& a_out, const std::string_view a_str)
+		{
+			for (const char c : a_str) {
+				switch (c) {
+				case '"':
+					a_out += "\\\"";
+					break;
+				case '\\':
+					a_out += "\\\\";
+					break;
+				case '\n':
+					a_out += "\\n";
+					break;
+				case '\t':
+					a_out += "\\t";
+					break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20) {
+						a_out += std::format("\\u{:04x}", static_cast<unsigned char>(c));
+					} else {
+						a_out += c;
+					}
+					break;
+				}
+			}
+		}
+
+		void AppendReport(std::string& a_out, const MemoryReport& a_report, size_t a_depth)
+		{
+			const std::string indent(a_depth * 2, ' ');
+			a_out += indent + "{\n";
+			a_out += indent + "  \"name\": \"";
+			AppendEscaped(a_out, a_report.name);
+			a_out += "\",\n";
+			a_out += std::format("{}  \"bytes\": {},\n", indent, a_report.bytes);
+			a_out += std::format("{}  \"total_bytes\": {},\n", indent, a_report.GetTotalBytes());
+			a_out += indent + "  \"children\": [";
+			bool first = true;
+			for (auto& c : a_report.children) {
+				a_out += first ? "\n" : ",\n";
+				first = false;
+				AppendReport(a_out, c, a_depth + 2);
+			}
+			a_out += a_report.children.empty() ? "]\n" : "\n" + indent + "  ]\n";
+			a_out += indent + "}";
+		}
+	}
+
+	MemoryReport& MemoryReport::AddChild(const std::string_view a_name, size_t a_bytes)
+	{
+		auto& result = children.emplace_back();
+		result.name = a_name;
+		result.bytes = a_bytes;
+		return result;
+	}
+
+	size_t MemoryReport::GetTotalBytes() const
+	{
+		size_t result = bytes;
+		for (auto& c : children) {
+			result += c.GetTotalBytes();
+		}
+		return result;
+	}
+
+	void InstallOzzAllocator()
+	{
+#ifdef NAF_MEMORY_TELEMETRY
+		static std::once_flag installed;
+		std::call_once(installed, [] {
+			static detail::CountingOzzAllocator allocator(ozz::memory::default_allocator());
+			ozz::memory::SetDefaulAllocator(&allocator);
+		});
+#endif
+	}
+
+	std::vector<TagStats> GetTagStats()
+	{
+		std::vector<TagStats> result;
+		for (size_t i = 0; i < detail::counters.size(); i++) {
+			auto& c = detail::counters[i];
+			result.push_back({ .name = detail::TAG_NAMES[i],
+				.bytes = c.bytes.load(std::memory_order_relaxed),
+				.peakBytes = c.peakBytes.load(std::memory_order_relaxed),
+				.liveAllocations = c.liveAllocations.load(std::memory_order_relaxed) });
+		}
+		return result;
+	}
+
+	std::string ToJson(const MemoryReport& a_report)
+	{
+		std::string result = "{\n  \"allocators\": [";
+		auto tags = GetTagStats();
+		for (size_t i = 0; i < tags.size(); i++) {
+			const auto& t = tags[i];
+			result += std::format("{}\n    {{ \"name\": \"{}\", \"bytes\": {}, \"peak_bytes\": {}, \"live_allocations\": {} }}",
+				i == 0 ? "" : ",", t.name, t.bytes, t.peakBytes, t.liveAllocations);
+		}
+		result += "\n  ],\n  \"report\":\n";
+		detail::AppendReport(result, a_report, 1);
+		result += "\n}\n";
+		return result;
+	}
+
+	bool WriteJson(const std::filesystem::path& a_path, const MemoryReport& a_report)
+	{
+		std::ofstream file(a_path, std::ios::trunc);
+		if (!file.is_open()) {
+			logger::warn("Failed to open '{}' for writing.", a_path.string());
+			return false;
+		}
+
+		file << ToJson(a_report);
+		return file.good();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#pragma once
+
+namespace Util::Memory
+{
+	enum class Tag : uint8_t
+	{
+		kPoseCache,
+		kOzz,
+
+		kTotal
+	};
+
+	struct TagStats
+	{
+		std::string_view name;
+		int64_t bytes = 0;
+		int64_t peakBytes = 0;
+		int64_t liveAllocations = 0;
+	};
+
+	namespace detail
+	{
+		struct Counter
+		{
+			std::atomic<int64_t> bytes{ 0 };
+			std::atomic<int64_t> peakBytes{ 0 };
+			std::atomic<int64_t> liveAllocations{ 0 };
+		};
+
+		inline std::array<Counter, static_cast<size_t>(Tag::kTotal)> counters;
+
+		inline void OnAllocate(Tag a_tag, size_t a_bytes)
+		{
+			auto& c = counters[static_cast<size_t>(a_tag)];
+			const int64_t bytes = c.bytes.fetch_add(static_cast<int64_t>(a_bytes), std::memory_order_relaxed) + static_cast<int64_t>(a_bytes);
+			c.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+
+			int64_t peak = c.peakBytes.load(std::memory_order_relaxed);
+			while (bytes > peak && !c.peakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {}
+		}
+
+		inline void OnDeallocate(Tag a_tag, size_t a_bytes)
+		{
+			auto& c = counters[static_cast<size_t>(a_tag)];
+			c.bytes.fetch_sub(static_cast<int64_t>(a_bytes), std::memory_order_relaxed);
+			c.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+	// Drop-in std allocator that keeps a live count of the bytes requested per tag.
+	template <typename T, Tag TAG>
+	class CountingAllocator
+	{
+	public:
+		using value_type = T;
+
+		template <typename U>
+		struct rebind
+		{
+			using other = CountingAllocator<U, TAG>;
+		};
+
+		CountingAllocator() noexcept = default;
+
+		template <typename U>
+		CountingAllocator(const CountingAllocator<U, TAG>&) noexcept
+		{
+		}
+
+		T* allocate(size_t a_count)
+		{
+			T* result = std::allocator<T>{}.allocate(a_count);
+			detail::OnAllocate(TAG, a_count * sizeof(T));
+			return result;
+		}
+
+		void deallocate(T* a_ptr, size_t a_count) noexcept
+		{
+			detail::OnDeallocate(TAG, a_count * sizeof(T));
+			std::allocator<T>{}.deallocate(a_ptr, a_count);
+		}
+
+		template <typename U>
+		bool operator==(const CountingAllocator<U, TAG>&) const noexcept
+		{
+			return true;
+		}
+	};
+
+	template <typename T, Tag TAG>
+	using CountedVector = std::vector<T, CountingAllocator<T, TAG>>;
+
+	// Only vectors are measured, since their heap usage is their capacity, give or take the heap's own overhead. Containers with implementation-defined
+	// layouts (node-based containers, std::vector<bool>) should be avoided in anything that's reported.
+	template <typename T, typename A>
+		requires(!std::is_same_v<T, bool>)
+	inline size_t GetHeapBytes(const std::vector<T, A>& a_vec)
+	{
+		return a_vec.capacity() * sizeof(T);
+	}
+
+	struct MemoryReport
+	{
+		std::string name;
+		size_t bytes = 0;
+		// A list, so the reference AddChild returns stays valid while more children are added.
+		std::list<MemoryReport> children;
+
+		MemoryReport& AddChild(const std::string_view a_name, size_t a_bytes = 0);
+		size_t GetTotalBytes() const;
+	};
+
+	// Routes all ozz allocations (skeletons, animations, sampling contexts) through the kOzz counter. Can be called more
+	// than once. Blocks allocated through ozz before the first call aren't counted. Counting takes a lock on every ozz
+	// allocation, so this does nothing unless NAF_MEMORY_TELEMETRY is defined.
+	void InstallOzzAllocator();
+	std::vector<TagStats> GetTagStats();
+
+	std::string ToJson(const MemoryReport& a_report);
+	bool WriteJson(const std::filesystem::path& a_path, const MemoryReport& a_report);
+}
\ No newline at end of file
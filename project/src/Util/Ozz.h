@@ -1,5 +1,6 @@
 #pragma once
 #include "Util/String.h"
+#include "Util/BoneMask.h"
 #include "Animation/Transform.h"
 
 namespace Util::Ozz
@@ -111,6 +112,65 @@ namespace Util::Ozz
 		}
 	}
 
+	// Returns a_true's lanes where a_mask is set, and a_false's lanes everywhere else.
+	inline ozz::math::SoaTransform SelectSoaTransform(const ozz::math::SimdInt4& a_mask, const ozz::math::SoaTransform& a_true, const ozz::math::SoaTransform& a_false)
+	{
+		using namespace ozz::math;
+		return {
+			{ Select(a_mask, a_true.translation.x, a_false.translation.x), Select(a_mask, a_true.translation.y, a_false.translation.y), Select(a_mask, a_true.translation.z, a_false.translation.z) },
+			{ Select(a_mask, a_true.rotation.x, a_false.rotation.x), Select(a_mask, a_true.rotation.y, a_false.rotation.y), Select(a_mask, a_true.rotation.z, a_false.rotation.z), Select(a_mask, a_true.rotation.w, a_false.rotation.w) },
+			{ Select(a_mask, a_true.scale.x, a_false.scale.x), Select(a_mask, a_true.scale.y, a_false.scale.y), Select(a_mask, a_true.scale.z, a_false.scale.z) }
+		};
+	}
+
+	// Packs the game's local transforms into SoA form, falling back to the skeleton's rest pose for joints the game doesn't control.
+	// Only SoA lanes [a_beginLane, a_endLane) are written. Returns false without writing anything if the spans don't match
+	// the skeleton.
+	inline bool PackRestPose(const std::span<ozz::math::Float4x4*>& a_input, const Util::BoneMask& a_controlledByGame, const std::span<ozz::math::SoaTransform>& a_output, const ozz::animation::Skeleton* a_skeleton,
+		size_t a_beginLane = 0, size_t a_endLane = SIZE_MAX)
+	{
+		const int end = a_skeleton->num_joints();
+		if (a_input.size() < end || a_controlledByGame.size() < end || a_output.size() != a_skeleton->num_soa_joints()) {
+			assert(false && "PackRestPose input doesn't match the skeleton");
+			return false;
+		}
+
+		// The skeleton's rest pose is already stored as SoA, so joints the game doesn't control never need to be transposed.
+		const auto restPoses = a_skeleton->joint_rest_poses();
+		const size_t endLane = std::min(a_endLane, a_output.size());
+		for (size_t k = a_beginLane, i = k * 4; k < endLane; i += 4, k++) {
+			const uint8_t controlled = a_controlledByGame.lane_bits(k);
+			if (controlled == 0) {
+				a_output[k] = restPoses[k];
+				continue;
+			}
+
+			ozz::math::SimdFloat4 translations[4] = {};
+			ozz::math::SimdFloat4 rotations[4] = {};
+			ozz::math::SimdFloat4 scales[4] = {};
+
+			size_t remaining = std::min(4ui64, end - i);
+			for (int j = 0; j < remaining; j++) {
+				if (controlled & (1u << j)) {
+					ozz::math::ToAffine(*a_input[i + j], &translations[j], &rotations[j], &scales[j]);
+				}
+			}
+
+			ozz::math::SoaTransform gathered;
+			ozz::math::Transpose4x3(translations, &gathered.translation.x);
+			ozz::math::Transpose4x4(rotations, &gathered.rotation.x);
+			ozz::math::Transpose4x3(scales, &gathered.scale.x);
+
+			if (controlled == a_controlledByGame.lane_full_bits(k)) {
+				a_output[k] = gathered;
+			} else {
+				const ozz::math::SimdInt4 mask = ozz::math::simd_int4::Load(-(controlled & 1), -((controlled >> 1) & 1), -((controlled >> 2) & 1), -((controlled >> 3) & 1));
+				a_output[k] = SelectSoaTransform(mask, gathered, restPoses[k]);
+			}
+		}
+		return true;
+	}
+
 	inline void ApplySoATransformTranslation(int32_t a_index, const ozz::math::SimdFloat4& a_trans, const std::span<ozz::math::SoaTransform>& a_transforms)
 	{
 		ozz::math::SoaTransform& soa_transform_ref = a_transforms[a_index / 4];
@@ -0,0 +1,392 @@
+#include "Profiler.h"
+
+namespace Util::Profiler
+{
+	namespace detail
+	{
+		// Log-linear buckets: durations below 16 ticks get their own bucket, above that every power of two is split into 8 sub-buckets (~6% error).
+		constexpr size_t LINEAR_BUCKETS = 16;
+		constexpr size_t SUB_BUCKET_BITS = 3;
+		constexpr size_t SUB_BUCKETS = 1ull << SUB_BUCKET_BITS;
+		constexpr size_t NUM_BUCKETS = LINEAR_BUCKETS + (64 - 4) * SUB_BUCKETS;
+
+		// Without a reference frequency, assume 3GHz until enough time has passed to calibrate.
+		constexpr double FALLBACK_TICKS_PER_MS = 3'000'000.0;
+		constexpr double CALIBRATION_MIN_MS = 1000.0;
+
+		size_t GetBucketIndex(uint64_t a_ticks)
+		{
+			if (a_ticks < LINEAR_BUCKETS) {
+				return static_cast<size_t>(a_ticks);
+			}
+
+			const size_t log2 = std::bit_width(a_ticks) - 1;
+			const size_t sub = (a_ticks >> (log2 - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+			return LINEAR_BUCKETS + (log2 - 4) * SUB_BUCKETS + sub;
+		}
+
+		double GetBucketMidpoint(size_t a_idx)
+		{
+			if (a_idx < LINEAR_BUCKETS) {
+				return static_cast<double>(a_idx);
+			}
+
+			const size_t log2 = (a_idx - LINEAR_BUCKETS) / SUB_BUCKETS + 4;
+			const size_t sub = (a_idx - LINEAR_BUCKETS) % SUB_BUCKETS;
+			const double width = std::ldexp(1.0, static_cast<int>(log2 - SUB_BUCKET_BITS));
+			return static_cast<double>(SUB_BUCKETS + sub) * width + width * 0.5;
+		}
+
+		struct Histogram
+		{
+			std::array<std::atomic<uint32_t>, NUM_BUCKETS> buckets{};
+			std::atomic<uint64_t> count{ 0 };
+			std::atomic<uint64_t> totalTicks{ 0 };
+			std::atomic<uint64_t> minTicks{ UINT64_MAX };
+			std::atomic<uint64_t> maxTicks{ 0 };
+			// Reset generation the histogram was last cleared for. Stale histograms are cleared by their owner on the next
+			// Record, and skipped by GetZoneStats until then.
+			std::atomic<uint64_t> generation{ 0 };
+
+			// Only the owning thread writes to a histogram, so relaxed load/store pairs are enough.
+			void Add(uint64_t a_ticks)
+			{
+				auto& b = buckets[GetBucketIndex(a_ticks)];
+				b.store(b.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				totalTicks.store(totalTicks.load(std::memory_order_relaxed) + a_ticks, std::memory_order_relaxed);
+				if (a_ticks < minTicks.load(std::memory_order_relaxed)) {
+					minTicks.store(a_ticks, std::memory_order_relaxed);
+				}
+				if (a_ticks > maxTicks.load(std::memory_order_relaxed)) {
+					maxTicks.store(a_ticks, std::memory_order_relaxed);
+				}
+			}
+
+			void Clear()
+			{
+				for (auto& b : buckets) {
+					b.store(0, std::memory_order_relaxed);
+				}
+				count.store(0, std::memory_order_relaxed);
+				totalTicks.store(0, std::memory_order_relaxed);
+				minTicks.store(UINT64_MAX, std::memory_order_relaxed);
+				maxTicks.store(0, std::memory_order_relaxed);
+			}
+		};
+
+		struct Event
+		{
+			uint64_t start;
+			uint64_t end;
+			ZoneID zone;
+		};
+
+		struct ThreadData
+		{
+			uint32_t threadIdx = 0;
+			std::atomic<uint64_t> writeIdx{ 0 };
+			std::atomic<uint64_t> readStart{ 0 };
+			std::array<Event, RING_BUFFER_SIZE> events;
+			std::array<std::atomic<Histogram*>, MAX_ZONES> histograms{};
+
+			~ThreadData()
+			{
+				for (auto& h : histograms) {
+					delete h.load(std::memory_order_relaxed);
+				}
+			}
+		};
+
+		struct Registry
+		{
+			std::mutex lock;
+			std::array<std::string, MAX_ZONES> names;
+			std::atomic<size_t> numZones{ 0 };
+			std::unordered_map<std::string_view, ZoneID> nameMap;
+			std::vector<std::shared_ptr<ThreadData>> threads;
+			std::atomic<double> ticksPerMs{ 0.0 };
+			std::atomic<uint64_t> generation{ 0 };
+			const uint64_t startTicks = ReadTimestamp();
+			const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+			Registry()
+			{
+				names[OVERFLOW_ZONE] = "<overflow>";
+				nameMap.emplace(names[OVERFLOW_ZONE], OVERFLOW_ZONE);
+				numZones.store(1, std::memory_order_release);
+			}
+		};
+
+		Registry& GetRegistry()
+		{
+			static Registry instance;
+			return instance;
+		}
+
+		ThreadData& GetThreadData()
+		{
+			// Thread data is shared with the registry so events recorded by a thread can still be dumped after it exits.
+			thread_local std::shared_ptr<ThreadData> data = [] {
+				auto& r = GetRegistry();
+				auto result = std::make_shared<ThreadData>();
+				std::unique_lock l{ r.lock };
+				result->threadIdx = static_cast<uint32_t>(r.threads.size());
+				r.threads.push_back(result);
+				return result;
+			}();
+			return *data;
+		}
+
+		double GetTicksPerMs()
+		{
+			auto& r = GetRegistry();
+			if (double cached = r.ticksPerMs.load(std::memory_order_relaxed); cached > 0.0) {
+				return cached;
+			}
+
+			const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - r.startTime).count();
+			const uint64_t elapsedTicks = ReadTimestamp() - r.startTicks;
+			if (elapsedMs <= 0.0 || elapsedTicks == 0) {
+				return FALLBACK_TICKS_PER_MS;
+			}
+
+			const double result = static_cast<double>(elapsedTicks) / elapsedMs;
+			if (elapsedMs >= CALIBRATION_MIN_MS) {
+				r.ticksPerMs.store(result, std::memory_order_relaxed);
+			}
+			return result;
+		}
+
+		double GetPercentileTicks(const std::vector<uint64_t>& a_buckets, uint64_t a_count, double a_percentile)
+		{
+			const uint64_t rank = std::max(static_cast<uint64_t>(std::ceil(a_percentile * static_cast<double>(a_count))), 1ull);
+			uint64_t cumulative = 0;
+			for (size_t i = 0; i < a_buckets.size(); i++) {
+				cumulative += a_buckets[i];
+				if (cumulative >= rank) {
+					return GetBucketMidpoint(i);
+				}
+			}
+			return GetBucketMidpoint(a_buckets.size() - 1);
+		}
+
+		std::string EscapeName(const std::string_view a_name)
+		{
+			std::string result;
+			result.reserve(a_name.size());
+			for (char c : a_name) {
+				if (c == '"' || c == '\\') {
+					result += '\\';
+				}
+				result += c;
+			}
+			return result;
+		}
+	}
+
+	ZoneID RegisterZone(const std::string_view a_name)
+	{
+		auto& r = detail::GetRegistry();
+		std::unique_lock l{ r.lock };
+
+		if (auto iter = r.nameMap.find(a_name); iter != r.nameMap.end()) {
+			return iter->second;
+		}
+
+		const size_t idx = r.numZones.load(std::memory_order_relaxed);
+		if (idx >= MAX_ZONES) {
+			return OVERFLOW_ZONE;
+		}
+
+		r.names[idx] = a_name;
+		r.nameMap.emplace(r.names[idx], static_cast<ZoneID>(idx));
+		r.numZones.store(idx + 1, std::memory_order_release);
+		return static_cast<ZoneID>(idx);
+	}
+
+	std::string_view GetZoneName(ZoneID a_zone)
+	{
+		auto& r = detail::GetRegistry();
+		if (a_zone >= r.numZones.load(std::memory_order_acquire)) {
+			return r.names[OVERFLOW_ZONE];
+		}
+		return r.names[a_zone];
+	}
+
+	void Record(ZoneID a_zone, uint64_t a_start, uint64_t a_end)
+	{
+		if (a_zone >= MAX_ZONES) {
+			a_zone = OVERFLOW_ZONE;
+		}
+
+		auto& t = detail::GetThreadData();
+		const uint64_t idx = t.writeIdx.load(std::memory_order_relaxed);
+		t.events[idx & (RING_BUFFER_SIZE - 1)] = { a_start, a_end, a_zone };
+		t.writeIdx.store(idx + 1, std::memory_order_release);
+
+		const uint64_t generation = detail::GetRegistry().generation.load(std::memory_order_acquire);
+		auto h = t.histograms[a_zone].load(std::memory_order_relaxed);
+		if (!h) {
+			h = new detail::Histogram();
+			h->generation.store(generation, std::memory_order_relaxed);
+			t.histograms[a_zone].store(h, std::memory_order_release);
+		} else if (h->generation.load(std::memory_order_relaxed) != generation) {
+			h->Clear();
+			h->generation.store(generation, std::memory_order_release);
+		}
+		h->Add(a_end > a_start ? a_end - a_start : 0);
+	}
+
+	double TicksToMs(uint64_t a_ticks)
+	{
+		return static_cast<double>(a_ticks) / detail::GetTicksPerMs();
+	}
+
+	void SetEnabled(bool a_enabled)
+	{
+		detail::enabled.store(a_enabled, std::memory_order_relaxed);
+	}
+
+	bool IsEnabled()
+	{
+		return detail::enabled.load(std::memory_order_relaxed);
+	}
+
+	void SetDetailedEnabled(bool a_enabled)
+	{
+		detail::detailedEnabled.store(a_enabled, std::memory_order_relaxed);
+	}
+
+	std::vector<ZoneStats> GetZoneStats()
+	{
+		auto& r = detail::GetRegistry();
+		std::unique_lock l{ r.lock };
+
+		std::vector<ZoneStats> result;
+		std::vector<uint64_t> merged(detail::NUM_BUCKETS);
+		const size_t numZones = r.numZones.load(std::memory_order_acquire);
+		const uint64_t generation = r.generation.load(std::memory_order_relaxed);
+
+		for (size_t zone = 0; zone < numZones; zone++) {
+			std::fill(merged.begin(), merged.end(), 0);
+			uint64_t count = 0;
+			uint64_t totalTicks = 0;
+			uint64_t minTicks = UINT64_MAX;
+			uint64_t maxTicks = 0;
+
+			for (auto& t : r.threads) {
+				auto h = t->histograms[zone].load(std::memory_order_acquire);
+				if (!h || h->generation.load(std::memory_order_acquire) != generation)
+					continue;
+
+				for (size_t i = 0; i < detail::NUM_BUCKETS; i++) {
+					merged[i] += h->buckets[i].load(std::memory_order_relaxed);
+				}
+				count += h->count.load(std::memory_order_relaxed);
+				totalTicks += h->totalTicks.load(std::memory_order_relaxed);
+				minTicks = std::min(minTicks, h->minTicks.load(std::memory_order_relaxed));
+				maxTicks = std::max(maxTicks, h->maxTicks.load(std::memory_order_relaxed));
+			}
+
+			if (count == 0)
+				continue;
+
+			auto ClampedPercentile = [&](double a_percentile) {
+				const double ticks = detail::GetPercentileTicks(merged, count, a_percentile);
+				return TicksToMs(static_cast<uint64_t>(std::clamp(ticks, static_cast<double>(minTicks), static_cast<double>(maxTicks))));
+			};
+
+			auto& s = result.emplace_back();
+			s.name = r.names[zone];
+			s.count = count;
+			s.totalMs = TicksToMs(totalTicks);
+			s.minMs = TicksToMs(minTicks);
+			s.maxMs = TicksToMs(maxTicks);
+			s.p50Ms = ClampedPercentile(0.50);
+			s.p95Ms = ClampedPercentile(0.95);
+			s.p99Ms = ClampedPercentile(0.99);
+		}
+
+		return result;
+	}
+
+	std::optional<ZoneStats> GetZoneStats(const std::string_view a_name)
+	{
+		for (auto& s : GetZoneStats()) {
+			if (s.name == a_name) {
+				return s;
+			}
+		}
+		return std::nullopt;
+	}
+
+	void Reset()
+	{
+		// Histograms are only ever written by their owning thread, so rather than clearing them here, this starts a new
+		// generation and each owner clears its own histograms the next time it records to them.
+		auto& r = detail::GetRegistry();
+		std::unique_lock l{ r.lock };
+		r.generation.fetch_add(1, std::memory_order_release);
+		for (auto& t : r.threads) {
+			t->readStart.store(t->writeIdx.load(std::memory_order_acquire), std::memory_order_relaxed);
+		}
+	}
+
+	bool DumpChromeTrace(const std::filesystem::path& a_path)
+	{
+		struct ThreadEvents
+		{
+			uint32_t threadIdx;
+			std::vector<detail::Event> events;
+		};
+
+		std::vector<ThreadEvents> collected;
+		uint64_t baseTicks = UINT64_MAX;
+		{
+			auto& r = detail::GetRegistry();
+			std::unique_lock l{ r.lock };
+			for (auto& t : r.threads) {
+				const uint64_t end = t->writeIdx.load(std::memory_order_acquire);
+				const uint64_t begin = std::max(t->readStart.load(std::memory_order_relaxed), end > RING_BUFFER_SIZE ? end - RING_BUFFER_SIZE : 0);
+
+				auto& c = collected.emplace_back(t->threadIdx);
+				c.events.reserve(end - begin);
+				for (uint64_t i = begin; i < end; i++) {
+					const auto& e = t->events[i & (RING_BUFFER_SIZE - 1)];
+					c.events.push_back(e);
+					baseTicks = std::min(baseTicks, e.start);
+				}
+			}
+		}
+
+		std::ofstream file(a_path, std::ios::out | std::ios::trunc);
+		if (!file.good()) {
+			logger::warn("Failed to open {} for writing profiler trace.", a_path.generic_string());
+			return false;
+		}
+
+		std::vector<std::string> names;
+		for (ZoneID i = 0; i < MAX_ZONES; i++) {
+			names.push_back(detail::EscapeName(GetZoneName(i)));
+		}
+
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		bool first = true;
+		for (auto& c : collected) {
+			for (auto& e : c.events) {
+				if (!first) {
+					file << ",";
+				}
+				first = false;
+
+				const double ts = TicksToMs(e.start - baseTicks) * 1000.0;
+				const double dur = TicksToMs(e.end > e.start ? e.end - e.start : 0) * 1000.0;
+				file << std::format("\n{{\"name\":\"{}\",\"cat\":\"naf\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}", names[e.zone], c.threadIdx, ts, dur);
+			}
+		}
+		file << "\n]}\n";
+
+		return file.good();
+	}
+}
\ No newline at end of file
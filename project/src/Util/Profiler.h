@@ -0,0 +1,104 @@
+#pragma once
+#include <intrin.h>
+
+namespace Util::Profiler
+{
+	using ZoneID = uint16_t;
+
+	inline constexpr size_t MAX_ZONES{ 1024 };
+	inline constexpr size_t RING_BUFFER_SIZE{ 1u << 13 };
+	inline constexpr ZoneID OVERFLOW_ZONE{ 0 };
+
+	struct ZoneStats
+	{
+		std::string_view name;
+		uint64_t count = 0;
+		double totalMs = 0.0;
+		double minMs = 0.0;
+		double maxMs = 0.0;
+		double p50Ms = 0.0;
+		double p95Ms = 0.0;
+		double p99Ms = 0.0;
+	};
+
+	namespace detail
+	{
+		inline std::atomic<bool> enabled{ true };
+		inline std::atomic<bool> detailedEnabled{ false };
+	}
+
+	// Zone names are copied, so any string can be registered. Registering the same name twice returns the same ID.
+	ZoneID RegisterZone(const std::string_view a_name);
+	std::string_view GetZoneName(ZoneID a_zone);
+	void Record(ZoneID a_zone, uint64_t a_start, uint64_t a_end);
+	double TicksToMs(uint64_t a_ticks);
+
+	void SetEnabled(bool a_enabled);
+	bool IsEnabled();
+	// Detailed zones are recorded at a much finer grain, such as once per graph node, so they're off by default. Callers
+	// check this before opening one, on top of the profiler being enabled.
+	void SetDetailedEnabled(bool a_enabled);
+
+	inline bool IsDetailedEnabled()
+	{
+		return detail::detailedEnabled.load(std::memory_order_relaxed);
+	}
+
+	// Stats are aggregated across all threads that have recorded zones since the last Reset().
+	std::vector<ZoneStats> GetZoneStats();
+	std::optional<ZoneStats> GetZoneStats(const std::string_view a_name);
+	void Reset();
+
+	// Writes the events still held in each thread's ring buffer in Chrome's trace event format (chrome://tracing, Perfetto).
+	bool DumpChromeTrace(const std::filesystem::path& a_path);
+
+	inline uint64_t ReadTimestamp()
+	{
+		return __rdtsc();
+	}
+
+	class ScopedZone
+	{
+	public:
+		ScopedZone(const ScopedZone&) = delete;
+		ScopedZone& operator=(const ScopedZone&) = delete;
+
+		inline ScopedZone(ZoneID a_zone, float* a_elapsedMsOut = nullptr) :
+			_zone(a_zone),
+			_elapsedMsOut(a_elapsedMsOut),
+			_record(detail::enabled.load(std::memory_order_relaxed)),
+			_start(_record || a_elapsedMsOut ? ReadTimestamp() : 0)
+		{
+		}
+
+		// The elapsed time is written even while the profiler is disabled, since callers report it on their own.
+		inline ~ScopedZone()
+		{
+			if (!_record && !_elapsedMsOut)
+				return;
+
+			const uint64_t end = ReadTimestamp();
+			if (_record) {
+				Record(_zone, _start, end);
+			}
+			if (_elapsedMsOut) {
+				*_elapsedMsOut = static_cast<float>(TicksToMs(end - _start));
+			}
+		}
+
+	private:
+		ZoneID _zone;
+		float* _elapsedMsOut;
+		bool _record;
+		uint64_t _start;
+	};
+}
+
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_IMPL(a, b)
+#define PROFILE_ZONE(name)                                                                                                 \
+	static const ::Util::Profiler::ZoneID PROFILER_CONCAT(_profilerZone, __LINE__) = ::Util::Profiler::RegisterZone(name); \
+	::Util::Profiler::ScopedZone PROFILER_CONCAT(_profilerScope, __LINE__)(PROFILER_CONCAT(_profilerZone, __LINE__))
+#define PROFILE_ZONE_ELAPSED(name, elapsedMsOut)                                                                           \
+	static const ::Util::Profiler::ZoneID PROFILER_CONCAT(_profilerZone, __LINE__) = ::Util::Profiler::RegisterZone(name); \
+	::Util::Profiler::ScopedZone PROFILER_CONCAT(_profilerScope, __LINE__)(PROFILER_CONCAT(_profilerZone, __LINE__), &(elapsedMsOut))
\ No newline at end of file
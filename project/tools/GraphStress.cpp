@@ -0,0 +1,30 @@
+#include "GraphStressBenchmark.h"
+
+// Runs the graph stress benchmark outside the game. Usage: NAF-Common-GraphStress [numGraphs] [numFrames] [threadCount...]
+int main(int argc, char** argv)
+{
+	const auto ParseArg = [&](int a_idx, size_t& a_out) {
+		if (a_idx >= argc)
+			return;
+
+		const std::string_view arg = argv[a_idx];
+		size_t value = 0;
+		if (std::from_chars(arg.data(), arg.data() + arg.size(), value).ec == std::errc{}) {
+			a_out = value;
+		}
+	};
+
+	Benchmark::GraphStressConfig config;
+	ParseArg(1, config.numGraphs);
+	ParseArg(2, config.numFrames);
+	if (argc > 3) {
+		config.threadCounts.clear();
+		for (int i = 3; i < argc; i++) {
+			ParseArg(i, config.threadCounts.emplace_back(0));
+		}
+	}
+
+	const auto results = Benchmark::RunGraphStressBenchmark(config);
+	Benchmark::LogGraphStressResults(results);
+	return results.empty() ? 1 : 0;
+}
\ No newline at end of file